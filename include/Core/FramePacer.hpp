@@ -0,0 +1,72 @@
+#ifndef SUPER_HAXAGON_FRAME_PACER_HPP
+#define SUPER_HAXAGON_FRAME_PACER_HPP
+
+#include <chrono>
+#include <cstddef>
+
+namespace SuperHaxagon {
+	/**
+	 * Holds frames to a fixed rate, with or without vsync. Sleeping is only as
+	 * accurate as the scheduler feels like being, so it sleeps until a little
+	 * before the deadline and spins the rest of the way. How far sleeps overshoot
+	 * is measured as it goes, so the spin only has to cover that.
+	 *
+	 * With vsync on, keep the rate at or under the refresh rate or the two
+	 * will fight over when frames start.
+	 */
+	class FramePacer {
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		/**
+		 * rate is in frames per second, 0 never waits.
+		 */
+		explicit FramePacer(double rate);
+
+		void setRate(double rate);
+		double getRate() const {return _rate;}
+
+		/**
+		 * Call once a frame, right before input is read.
+		 * Blocks until the frame is due.
+		 */
+		void wait();
+
+		/**
+		 * Frames that started more than LATE after they were due.
+		 */
+		size_t getMissed() const {return _missed;}
+
+		/**
+		 * How far sleeps overshoot, in seconds. Decays slowly after a bad one.
+		 */
+		double getSlop() const {return _slop;}
+
+		/**
+		 * How late the last frame started, in seconds.
+		 */
+		double getLate() const {return _late;}
+
+	private:
+		// Anything later than this counts as a missed deadline
+		static constexpr double LATE = 0.0002;
+
+		// Spun on top of the measured slop, and the least slop that is assumed
+		static constexpr double SPIN = 0.0002;
+		static constexpr double SLOP_MIN = 0.0005;
+
+		// How much of the worst overshoot is kept every frame
+		static constexpr double SLOP_DECAY = 0.99;
+
+		double _rate = 0;
+		Clock::duration _period{};
+		Clock::time_point _deadline{};
+		bool _started = false;
+
+		size_t _missed = 0;
+		double _slop = SLOP_MIN;
+		double _late = 0;
+	};
+}
+
+#endif //SUPER_HAXAGON_FRAME_PACER_HPP
@@ -0,0 +1,59 @@
+#ifndef SUPER_HAXAGON_FRAMEBUFFER_HPP
+#define SUPER_HAXAGON_FRAMEBUFFER_HPP
+
+#include "Structs.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace SuperHaxagon {
+	/**
+	 * A frame of pixels in memory, top row first. Each pixel is packed as
+	 * 0xAABBGGRR no matter the byte order. Doesn't touch any graphics API,
+	 * anything that ends up with pixels on the CPU can write them out with it.
+	 */
+	class Framebuffer {
+	public:
+		Framebuffer(int width, int height);
+		Framebuffer(Framebuffer&) = delete;
+		~Framebuffer();
+
+		void resize(int width, int height);
+
+		int getWidth() const {return _width;}
+		int getHeight() const {return _height;}
+
+		uint32_t* getRow(const int y) {return _pixels.data() + static_cast<size_t>(y) * _width;}
+		const uint32_t* getRow(const int y) const {return _pixels.data() + static_cast<size_t>(y) * _width;}
+
+		static uint32_t pack(const Color& color) {
+			return color.r | color.g << 8 | color.b << 16 | static_cast<uint32_t>(color.a) << 24;
+		}
+
+		static Color unpack(const uint32_t pixel) {
+			return {
+				static_cast<uint8_t>(pixel),
+				static_cast<uint8_t>(pixel >> 8),
+				static_cast<uint8_t>(pixel >> 16),
+				static_cast<uint8_t>(pixel >> 24)
+			};
+		}
+
+		/**
+		 * Writes a binary PPM, or a PNG if path ends in .png. Alpha is dropped.
+		 * The PNG isn't compressed, it's meant for looking at, not for keeping.
+		 * Returns false if the file couldn't be written.
+		 */
+		bool write(const std::string& path) const;
+		bool writePPM(const std::string& path) const;
+		bool writePNG(const std::string& path) const;
+
+	private:
+		int _width = 0;
+		int _height = 0;
+		std::vector<uint32_t> _pixels;
+	};
+}
+
+#endif //SUPER_HAXAGON_FRAMEBUFFER_HPP
@@ -3,17 +3,22 @@
 
 #include <deque>
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace SuperHaxagon {
 	// Maybe I went a bit overboard with PImpl...
 	struct Point;
 	struct Color;
+	struct Transform;
 	class LevelFactory;
 	class Audio;
 	class State;
 	class Pattern;
+	struct WallRun;
 	class Wall;
+	struct WallInstance;
+	struct WallTransform;
 	class Platform;
 	class Twist;
 	class Font;
@@ -29,12 +34,6 @@ namespace SuperHaxagon {
 
 		Platform& getPlatform() const {return _platform;}
 		Twist& getTwister() const {return *_twister;}
-		Audio& getSFXBegin() const {return *_sfxBegin;}
-		Audio& getSFXHexagon() const {return *_sfxHexagon;}
-		Audio& getSFXOver() const {return *_sfxOver;}
-		Audio& getSFXSelect() const {return *_sfxSelect;}
-		Audio& getSFXLevelUp() const {return *_sfxLevelUp;}
-		Audio& getSFXWonderful() const {return *_sfxWonderful;}
 		Audio* getBGMAudio() const {return _bgmAudio.get();}
 		Metadata* getBGMMetadata() const {return _bgmMetadata.get();}
 		Font& getFontSmall() const;
@@ -88,10 +87,19 @@ namespace SuperHaxagon {
 		void drawPatterns(const Color& color, const Point& focus, const std::deque<Pattern>& patterns, double rotation, double sides, double offset, double scale) const;
 
 		/**
-		 * Draws a single moving wall based on a live wall, a color, some rotational value, and the total
-		 * amount of sides that appears.
+		 * Pushes the shadow's offset, and until endShadow drawPatterns, drawRegular
+		 * and drawCursor keep every shape they draw as well. Culling covers the
+		 * screen both with and without the offset, so what was kept is enough
+		 * to draw the shapes again in place.
 		 */
-		void drawWalls(const Color& color, const Point& focus, const Wall& wall, double rotation, double sides, double offset, double scale) const;
+		void beginShadow(const Point& offset) const;
+		void endShadow() const;
+
+		/**
+		 * Draws everything kept since the last beginShadow again in color, without
+		 * the offset. Nothing is culled or worked out a second time.
+		 */
+		void drawShadowed(const Color& color) const;
 
 		/**
 		 * Gets the center of the screen from the platform
@@ -99,16 +107,67 @@ namespace SuperHaxagon {
 		Point getScreenCenter() const;
 
 		/**
-		 * Gets the offset in pixels of the shadow
+		 * Gets the offset in pixels of the shadow, on screen. Push it as a
+		 * translation to draw the same shapes again as their shadow.
 		 */
 		Point getShadowOffset() const;
 
 		/**
-		 * Skews the screen to give a 3D effect. Modifies the incoming triangle
+		 * Skews the screen to give a 3D effect. Every shape the game draws is
+		 * built without it, and goes through it on top of the platform's transform.
 		 */
-		void skew(std::vector<Point>& skew) const;
+		Transform getSkewTransform() const;
 
 	private:
+		/**
+		 * Closes out the platform's stats for this loop, and logs them when a report is due.
+		 */
+		void endFrame();
+
+		/**
+		 * Draws whatever the platform reported in getDebugInfo this loop, if anything.
+		 */
+		void drawDebug(double scale);
+
+		/**
+		 * Draws count moving walls in a row, starting with a live wall, based on a color, some rotational
+		 * value, and the total amount of sides that appears. They must share a distance and height.
+		 * Only for drawPatterns, it needs the skew pushed and the view up to date.
+		 */
+		void drawWalls(const Color& color, const Point& focus, const Wall& wall, int count, double rotation, double sides, double offset, double scale) const;
+
+		/**
+		 * Draws with the platform, and keeps the shape for drawShadowed if a shadow is being drawn.
+		 * Needs the skew pushed, like every other shape.
+		 */
+		void drawShape(const Color& color, const std::vector<Point>& points) const;
+		bool drawShapeStrip(const Color& color, const std::vector<Point>& points) const;
+
+		/**
+		 * Works out where the screen is before the platform's current transform,
+		 * for clip and updateReach. Only valid until the transform changes.
+		 */
+		void updateView() const;
+
+		/**
+		 * Clips a convex polygon to the screen, going by the last updateView.
+		 * Returns false if none of it is left to draw.
+		 */
+		bool clip(std::vector<Point>& points) const;
+
+		/**
+		 * Works out, for every side, how far from focus a wall can start and
+		 * still be seen. Only valid for the focus, rotation and sides it got,
+		 * and the last updateView.
+		 */
+		void updateReach(const Point& focus, double rotation, double sides) const;
+
+		/**
+		 * Trims a run of walls down to the ones that could end up on screen, going by
+		 * the last updateReach. Returns false if none of them could.
+		 */
+		bool isVisible(const std::vector<Wall>& walls, WallRun& run, double sides, double offset, double scale) const;
+
 		Platform& _platform;
 
 		std::vector<std::unique_ptr<LevelFactory>> _levels;
@@ -116,20 +175,36 @@ namespace SuperHaxagon {
 		std::unique_ptr<Twist> _twister;
 		std::unique_ptr<State> _state;
 
-		// Should really be an array of sfx
-		std::unique_ptr<Audio> _sfxBegin;
-		std::unique_ptr<Audio> _sfxHexagon;
-		std::unique_ptr<Audio> _sfxOver;
-		std::unique_ptr<Audio> _sfxSelect;
-		std::unique_ptr<Audio> _sfxLevelUp;
-		std::unique_ptr<Audio> _sfxWonderful;
-		
 		std::unique_ptr<Audio> _bgmAudio;
 		std::unique_ptr<Metadata> _bgmMetadata;
 		
 		std::unique_ptr<Font> _small;
 		std::unique_ptr<Font> _large;
 
+		// Reused every frame so batching walls never allocates
+		mutable std::vector<WallInstance> _walls;
+		mutable std::vector<Point> _view;
+		mutable std::vector<double> _reach;
+		mutable std::vector<Point> _clipped;
+		mutable std::vector<Point> _wedge;
+
+		struct Shape {
+			bool strip;
+			size_t start;
+			size_t count;
+		};
+
+		// Kept while drawing a shadow, see beginShadow
+		mutable bool _shadowing = false;
+		mutable double _shadowX = 0.0;
+		mutable double _shadowY = 0.0;
+		mutable std::vector<Shape> _shapes;
+		mutable std::vector<Point> _shapePoints;
+		mutable std::vector<Point> _shape;
+		mutable std::vector<WallInstance> _shadowWalls;
+		std::unique_ptr<WallTransform> _shadowWallTransform;
+		std::vector<std::string> _debug;
+
 		bool _running = true;
 		bool _shadowAuto = false;
 		double _skew = 0.0;
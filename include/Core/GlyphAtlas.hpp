@@ -0,0 +1,113 @@
+#ifndef SUPER_HAXAGON_GLYPH_ATLAS_HPP
+#define SUPER_HAXAGON_GLYPH_ATLAS_HPP
+
+#include "Structs.hpp"
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace SuperHaxagon {
+
+	/**
+	 * Rasterizes the printable ASCII range of a TrueType font into a single
+	 * 8 bit coverage texture. Doesn't touch any graphics API, so a driver only
+	 * has to upload getPixels once and draw the quads that layout hands back.
+	 */
+	class GlyphAtlas {
+	public:
+		static constexpr int GLYPH_START = 32;
+		static constexpr int GLYPH_END = 128;
+
+		// Empty pixels kept right of and below every glyph so filtering doesn't bleed between them
+		static constexpr int PADDING = 1;
+
+		struct Glyph {
+			double advance = 0;
+			Point offset{}; // From the pen on the baseline to the top left of the bitmap
+			Point size{};   // In pixels, zero for glyphs with nothing to draw
+			Point uv0{};    // Top left
+			Point uv1{};    // Bottom right
+		};
+
+		struct Quad {
+			Point position; // Top left, in pixels
+			Point size;
+			Point uv0;
+			Point uv1;
+		};
+
+		/**
+		 * Loads the font file at path and rasterizes it so that one em is size pixels.
+		 * Check isLoaded afterwards, nothing gets drawn if the font was unreadable.
+		 */
+		GlyphAtlas(const std::string& path, double size);
+
+		/**
+		 * Every visible character is a solid box and every advance the same,
+		 * so text lays out and draws identically whatever the font library
+		 * does. For golden runs, which hash whole frames.
+		 */
+		explicit GlyphAtlas(double size);
+
+		GlyphAtlas(GlyphAtlas&) = delete;
+		~GlyphAtlas();
+
+		bool isLoaded() const {return _loaded;}
+
+		/**
+		 * One byte of coverage per pixel, rows are getTextureWidth bytes long.
+		 */
+		const std::vector<uint8_t>& getPixels() const {return _pixels;}
+		int getTextureWidth() const {return _texWidth;}
+		int getTextureHeight() const {return _texHeight;}
+
+		/**
+		 * Distance from the baseline to the top of the tallest glyph.
+		 */
+		double getAscent() const {return _ascent;}
+
+		double getWidth(const std::string& text) const;
+		const Glyph& getGlyph(char c) const;
+
+		/**
+		 * Appends a quad for every visible character in text. position is the
+		 * top left of the line, the baseline sits getAscent pixels below it.
+		 * Positions are rounded to whole pixels so glyphs stay crisp.
+		 */
+		void layout(const std::string& text, const Point& position, std::vector<Quad>& quads) const;
+
+	private:
+		struct Node {
+			int x;
+			int y;
+			int width;
+		};
+
+		struct Box {
+			int c;
+			int x0, y0, x1, y1;
+		};
+
+		/**
+		 * Packs boxes into the texture and fills in where each glyph ended
+		 * up, draw rasterizes one of them at its spot in _pixels.
+		 */
+		template <typename Draw>
+		bool build(std::vector<Box>& boxes, Draw draw);
+
+		bool pack(int width, int height, int& x, int& y);
+
+		bool _loaded = false;
+		int _texWidth = 0;
+		int _texHeight = 0;
+		double _ascent = 0;
+
+		std::vector<uint8_t> _pixels;
+		std::vector<Node> _skyline;
+		std::array<Glyph, GLYPH_END> _glyphs{};
+	};
+}
+
+#endif //SUPER_HAXAGON_GLYPH_ATLAS_HPP
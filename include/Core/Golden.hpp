@@ -0,0 +1,125 @@
+#ifndef SUPER_HAXAGON_GOLDEN_HPP
+#define SUPER_HAXAGON_GOLDEN_HPP
+
+#include "../Driver/Platform.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace SuperHaxagon {
+	class Framebuffer;
+
+	enum class Budget {
+		POLYGONS,
+		DRAW_CALLS,
+		TEXT_DRAWS,
+		ALLOCATIONS,
+		TIME, // In calibration loops, so that one script holds on fast and slow machines
+		LAST // Unused, but used for iteration
+	};
+
+	/**
+	 * Replays a script on a headless driver and checks the frames it names
+	 * against stored hashes and budgets. Every frame is one tick and the twister
+	 * is always seeded the same, so a frame only changes when what it draws does.
+	 *
+	 * A script has one command per line, and # starts a comment:
+	 *   press FRAME BUTTON...            buttons are held down for one frame
+	 *   hold FIRST LAST BUTTON...        buttons are held down for a range of frames
+	 *   immortal FIRST LAST              walls don't kill for a range of frames
+	 *   check FRAME NAME HASH BUDGET...  FRAME is compared once it has been drawn
+	 *   audio HASH                       everything mixed over the run is compared
+	 *
+	 * Frames count from 0. Buttons are select, back, quit, left and right.
+	 * HASH is - until one is recorded, then only the budgets are checked.
+	 * Budgets are NAME=LIMIT with names polygons, calls, text, allocations
+	 * and time. A frame that doesn't match is written to the sdmc folder as
+	 * golden-NAME.png to look at.
+	 */
+	class Golden {
+	public:
+		/**
+		 * With update set, finish writes the script back with every hash as drawn.
+		 */
+		Golden(Platform& platform, const std::string& path, bool update);
+		Golden(Golden&) = delete;
+		~Golden();
+
+		bool isLoaded() const {return _loaded;}
+
+		/**
+		 * One past the last frame the script does anything on.
+		 */
+		uint64_t getFrames() const {return _frames;}
+
+		Buttons getPressed(uint64_t frame) const;
+		bool isImmortal(uint64_t frame) const;
+
+		/**
+		 * Call once frames have finished, with stats already ended for the last one
+		 * and allocations as a running total. Calls with no new frame are ignored.
+		 */
+		void endFrame(uint64_t frames, const Framebuffer& framebuffer, const Stats& stats, uint64_t allocations);
+
+		/**
+		 * Adds interleaved stereo audio to the audio hash, in the order it was mixed.
+		 */
+		void addAudio(const int16_t* samples, size_t frames);
+
+		/**
+		 * Reports every check, and writes the script back if updating. Returns
+		 * false if any check failed or was never reached.
+		 */
+		bool finish();
+
+		bool hasPassed() const {return _loaded && _failed == 0;}
+
+	private:
+		static constexpr size_t BUDGETS = static_cast<size_t>(Budget::LAST);
+
+		struct Input {
+			uint64_t first;
+			uint64_t last;
+			Buttons buttons;
+			bool immortal;
+		};
+
+		struct Check {
+			uint64_t frame;
+			std::string name;
+			std::string hash;
+			std::array<double, BUDGETS> limits;
+			size_t line; // In _lines, to write the hash back to
+			bool reached;
+		};
+
+		bool parse(const std::string& line, size_t number);
+		void compare(Check& check, const Framebuffer& framebuffer, const std::array<double, BUDGETS>& used);
+
+		Platform& _platform;
+		std::string _path;
+		bool _update;
+		bool _loaded = false;
+
+		std::vector<std::string> _lines;
+		std::vector<Input> _inputs;
+		std::vector<Check> _checks;
+		uint64_t _frames = 0;
+
+		std::string _audio; // Expected hash, empty if the script doesn't check audio
+		size_t _audioLine = 0;
+		uint64_t _audioHash;
+
+		double _calibration = 0.0; // Seconds one calibration loop takes
+		uint64_t _finished = 0;
+		uint64_t _allocations = 0;
+		std::chrono::steady_clock::time_point _last;
+		size_t _failed = 0;
+		size_t _unrecorded = 0;
+	};
+}
+
+#endif //SUPER_HAXAGON_GOLDEN_HPP
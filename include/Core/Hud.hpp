@@ -0,0 +1,71 @@
+#ifndef SUPER_HAXAGON_HUD_HPP
+#define SUPER_HAXAGON_HUD_HPP
+
+#include "Structs.hpp"
+
+#include <string>
+#include <vector>
+
+namespace SuperHaxagon {
+	enum class Alignment;
+	class Font;
+	class Platform;
+
+	/**
+	 * A line of HUD text that remembers what it last measured. Setting the
+	 * same text again, or measuring with the same font and scale, is free.
+	 */
+	class HudText {
+	public:
+		void set(const char* text);
+		void set(const std::string& text) {set(text.c_str());}
+
+		/**
+		 * Sets the text to prefix followed by the score formatted like getTime,
+		 * without allocating.
+		 */
+		void setTime(const char* prefix, double score);
+
+		const std::string& get() const {return _text;}
+
+		/**
+		 * The font should already be set to scale.
+		 */
+		double getWidth(const Font& font, double scale);
+		void draw(Font& font, const Color& color, const Point& position, Alignment alignment) const;
+
+	private:
+		std::string _text;
+		const Font* _font = nullptr;
+		double _scale = 0;
+		double _width = 0;
+		bool _dirty = true;
+	};
+
+	/**
+	 * The trapezoid drawn behind HUD text. The points are only rebuilt
+	 * when its size or the size of the screen changes.
+	 */
+	class HudPanel {
+	public:
+		enum class Anchor {
+			TOP_LEFT,
+			TOP_RIGHT,
+			TOP_CENTER,
+			BOTTOM_LEFT
+		};
+
+		explicit HudPanel(Anchor anchor) : _anchor(anchor) {}
+
+		void update(const Point& size, const Point& screen);
+		void draw(Platform& platform, const Color& color) const;
+
+	private:
+		Anchor _anchor;
+		Point _size{-1, -1};
+		Point _screen{-1, -1};
+		std::vector<Point> _points;
+	};
+}
+
+#endif //SUPER_HAXAGON_HUD_HPP
@@ -0,0 +1,52 @@
+#ifndef SUPER_HAXAGON_INPUT_SAMPLER_HPP
+#define SUPER_HAXAGON_INPUT_SAMPLER_HPP
+
+#include "Queue.hpp"
+#include "../Driver/Platform.hpp"
+
+#include <chrono>
+#include <vector>
+
+namespace SuperHaxagon {
+	/**
+	 * Queues every button change a driver records, with when it was recorded.
+	 * The game thread drains the queue once a frame, so a tap is seen even if
+	 * it was let go of before the frame, and how long each button was held is
+	 * known to within when the driver got to its events.
+	 *
+	 * Drivers stamp changes as they handle their window events, so holds are
+	 * only as fine as the event loop runs. A press and release handled in the
+	 * same pass are stamped together and count as held for no time at all.
+	 */
+	class InputSampler {
+	public:
+		InputSampler();
+		InputSampler(InputSampler&) = delete;
+
+		/**
+		 * Queues buttons, stamped now, if they differ from the last recorded.
+		 * Only ever call it from one thread.
+		 */
+		void record(const Buttons& buttons);
+
+		/**
+		 * Game thread. Replaces events with every change since the last call, oldest first.
+		 */
+		void poll(std::vector<InputEvent>& events);
+
+		/**
+		 * Seconds since the sampler was made, the same clock events are stamped with.
+		 */
+		double getTime() const;
+
+	private:
+		std::chrono::steady_clock::time_point _epoch;
+
+		// A second of changes, far more than anyone can press between two frames
+		Queue<InputEvent, 1024> _events;
+
+		Buttons _recorded{};
+	};
+}
+
+#endif //SUPER_HAXAGON_INPUT_SAMPLER_HPP
@@ -0,0 +1,185 @@
+#ifndef SUPER_HAXAGON_LOG_HPP
+#define SUPER_HAXAGON_LOG_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * Messages below SUPER_HAXAGON_LOG_LEVEL are compiled out of every
+ * LOG_MESSAGE, 0 keeps everything, 1 drops INFO and 2 drops WARN too.
+ * FATAL is always kept.
+ */
+#ifndef SUPER_HAXAGON_LOG_LEVEL
+#define SUPER_HAXAGON_LOG_LEVEL 0
+#endif
+
+/**
+ * Lets the compiler check a printf style format against its arguments,
+ * counting this as the first argument of a member function.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define SUPER_HAXAGON_PRINTF(string, first) __attribute__((format(printf, string, first)))
+#else
+#define SUPER_HAXAGON_PRINTF(string, first)
+#endif
+
+/**
+ * Sends a message through platform, unless its level is compiled out or this
+ * call site has already sent LOG_BURST messages in the last second. text is
+ * only built if the message is sent, and how many were held back is sent
+ * along with the next one that gets through.
+ */
+#define LOG_MESSAGE(platform, level, where, text) do { \
+	if (SuperHaxagon::logEnabled(level)) { \
+		static SuperHaxagon::LogLimit logLimit; \
+		uint32_t logSuppressed = 0; \
+		if (logLimit.allow(logSuppressed)) { \
+			if (logSuppressed) (platform).messagef(level, where, "%u similar messages suppressed", logSuppressed); \
+			(platform).message(level, where, text); \
+		} \
+	} \
+} while (false)
+
+/**
+ * LOG_MESSAGE with a printf style format. It's only expanded into the log's
+ * ring, so a message that gets through doesn't allocate either.
+ */
+#define LOG_MESSAGEF(platform, level, where, ...) do { \
+	if (SuperHaxagon::logEnabled(level)) { \
+		static SuperHaxagon::LogLimit logLimit; \
+		uint32_t logSuppressed = 0; \
+		if (logLimit.allow(logSuppressed)) { \
+			if (logSuppressed) (platform).messagef(level, where, "%u similar messages suppressed", logSuppressed); \
+			(platform).messagef(level, where, __VA_ARGS__); \
+		} \
+	} \
+} while (false)
+
+namespace SuperHaxagon {
+	enum class Dbg {
+		INFO,
+		WARN,
+		FATAL
+	};
+
+	static constexpr size_t LOG_SLOTS = 128;
+	static constexpr size_t LOG_WHERE = 16;
+	static constexpr size_t LOG_TEXT = 240;
+	static constexpr uint32_t LOG_BURST = 8;
+
+	constexpr bool logEnabled(const Dbg level) {
+		return level == Dbg::FATAL || static_cast<int>(level) >= SUPER_HAXAGON_LOG_LEVEL;
+	}
+
+	/**
+	 * Use LOG_MESSAGE instead, it keeps one of these for every call site.
+	 */
+	class LogLimit {
+	public:
+		/**
+		 * Returns false once LOG_BURST messages have gone through this second.
+		 * suppressed is set to how many were held back when a new second starts.
+		 */
+		bool allow(uint32_t& suppressed);
+
+	private:
+		std::atomic<int64_t> _second{-1};
+		std::atomic<uint32_t> _sent{0};
+		std::atomic<uint32_t> _suppressed{0};
+	};
+
+	/**
+	 * Drivers hand every message to one of these instead of writing it out.
+	 * Any thread can push, which copies the message into a fixed slot of a
+	 * lock free ring. push itself doesn't allocate, but a message built out
+	 * of std::strings already has by the time it gets here. vpush expands its
+	 * format into the slot on the calling thread instead, so the arguments
+	 * don't have to outlive the call. A background thread adds the prefix,
+	 * level and where to each line and hands it to the sink, so a slow
+	 * console or SD card never holds up the game. FATAL messages are written
+	 * out before push returns.
+	 *
+	 * If the ring fills up messages are dropped, and the sink is told how many.
+	 * Messages longer than LOG_TEXT are cut short.
+	 */
+	class Log {
+	public:
+		/**
+		 * Called on the flusher thread with one formatted line at a time,
+		 * last is set on the final line of a batch so the sink can flush.
+		 */
+		using Sink = std::function<void(Dbg dbg, const std::string& line, bool last)>;
+
+		/**
+		 * A sink for drivers with a console, FATAL goes to stderr and the rest to stdout.
+		 */
+		static void console(Dbg dbg, const std::string& line, bool last);
+
+		Log(const char* prefix, Sink sink);
+		Log(Log&) = delete;
+		~Log();
+
+		void push(Dbg dbg, const std::string& where, const std::string& message);
+
+		/**
+		 * Expands a printf style format into a slot with vsnprintf, on the
+		 * calling thread. where is cut short like the message is.
+		 */
+		void vpush(Dbg dbg, const char* where, const char* format, va_list args);
+
+		/**
+		 * Writes out everything pushed so far on the calling thread.
+		 */
+		void flush();
+
+		/**
+		 * Stops the flusher and writes out what's left. Anything pushed after
+		 * is written out straight away, drivers stop before they read back
+		 * what their sink kept.
+		 */
+		void stop();
+
+	private:
+		struct Slot {
+			std::atomic<size_t> sequence{0};
+			Dbg dbg = Dbg::INFO;
+			bool truncated = false;
+			uint8_t whereLength = 0;
+			uint8_t textLength = 0;
+			char where[LOG_WHERE]{};
+			char text[LOG_TEXT + 1]{}; // vsnprintf always ends on a null
+		};
+
+		Slot* claim(size_t& position);
+		void publish(Slot* slot, size_t position);
+		void run();
+
+		const char* _prefix;
+		Sink _sink;
+
+		std::unique_ptr<Slot[]> _slots;
+		std::atomic<size_t> _head{0};
+		std::atomic<uint32_t> _dropped{0};
+
+		// Only the consumer side locks, whoever is writing lines out
+		std::mutex _drain;
+		size_t _tail = 0;
+		std::string _line;
+		std::string _held;
+
+		std::mutex _wake;
+		std::condition_variable _wakeup;
+		std::atomic<bool> _running{true};
+		std::thread _flusher;
+	};
+}
+
+#endif //SUPER_HAXAGON_LOG_HPP
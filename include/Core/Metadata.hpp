@@ -1,24 +1,59 @@
 #ifndef SUPER_HAXAGON_METADATA_HPP
 #define SUPER_HAXAGON_METADATA_HPP
 
-#include <map>
+#include <cstdint>
 #include <string>
 #include <vector>
 
 namespace SuperHaxagon {
+	// Every label the game knows how to react to. Labels are interned
+	// into these when the metadata file is loaded, anything else is dropped.
+	enum class Label {
+		SPIN = 0,    // S
+		INVERT,      // I
+		PULSE_LARGE, // BL
+		PULSE_SMALL, // BS
+		HYPER,       // HYPER
+		SURROUND,    // PSURROUND
+		CREDITS,     // C
+		LEVEL_0,     // L0 through L6, must stay in order
+		LEVEL_1,
+		LEVEL_2,
+		LEVEL_3,
+		LEVEL_4,
+		LEVEL_5,
+		LEVEL_6,
+		LAST // Unused, but used for iteration
+	};
+
 	class Metadata {
 	public:
 		explicit Metadata(const std::string& path);
 		~Metadata();
 		Metadata& operator=(const Metadata&) = delete;
-		
-		bool getMetadata(double time, const std::string& label);
+
+		/**
+		 * Moves the timeline up to time and returns a bitmask of every label
+		 * that fired since the last call. Call it once per tick and test
+		 * the result with mask(). Seeking more than 10 seconds backwards
+		 * (for example, the music looped) repositions the timeline.
+		 */
+		uint32_t advance(double time);
+
+		static constexpr uint32_t mask(const Label label) {
+			return 1u << static_cast<unsigned int>(label);
+		}
 
 	private:
+		struct Event {
+			double time;
+			Label label;
+		};
+
 		double _time = 0;
-		std::map<std::string, std::vector<double>> _timestamps;
-		std::map<std::string, size_t> _indices;
+		size_t _cursor = 0;
+		std::vector<Event> _events;
 	};
 }
 
-#endif //SUPER_HAXAGON_METADATA_HPP
\ No newline at end of file
+#endif //SUPER_HAXAGON_METADATA_HPP
@@ -0,0 +1,208 @@
+#ifndef SUPER_HAXAGON_MIXER_HPP
+#define SUPER_HAXAGON_MIXER_HPP
+
+#include "Queue.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace SuperHaxagon {
+
+	/**
+	 * Fully decoded, interleaved 16 bit audio. Used for sound effects.
+	 * Doesn't own the samples, whatever does has to outlive the mixer.
+	 */
+	struct Pcm {
+		const int16_t* samples = nullptr;
+		size_t frames = 0;
+		unsigned int channels = 1;
+		unsigned int rate = 44100;
+	};
+
+	/**
+	 * Audio that is decoded while it plays, like the BGM. Only the mixer thread
+	 * reads from it, the game thread should only look at getTime and isDone.
+	 */
+	class MixerStream {
+	public:
+		MixerStream() = default;
+		MixerStream(MixerStream&) = delete;
+		virtual ~MixerStream() = default;
+
+		virtual unsigned int getChannels() const = 0;
+		virtual unsigned int getRate() const = 0;
+
+		/**
+		 * Decodes up to frames frames into out, returning the amount read.
+		 * Anything less than frames means the end of the stream was reached.
+		 */
+		virtual size_t read(int16_t* out, size_t frames) = 0;
+		virtual void rewind() = 0;
+
+		double getTime() const {return static_cast<double>(_frames.load(std::memory_order_acquire)) / getRate();}
+		bool isDone() const {return _done.load(std::memory_order_acquire);}
+
+	private:
+		friend class Mixer;
+
+		// Written by the mixer thread
+		std::atomic<uint64_t> _frames{0};
+		std::atomic<bool> _done{false};
+	};
+
+	/**
+	 * Where the mixer sends everything it renders. write is called on the
+	 * mixer thread and is expected to block to pace the mixer to real time.
+	 */
+	class MixerSink {
+	public:
+		MixerSink() = default;
+		MixerSink(MixerSink&) = delete;
+		virtual ~MixerSink() = default;
+
+		virtual void write(const int16_t* samples, size_t frames) = 0;
+
+		/**
+		 * How long audio written now takes to be heard, in seconds. Called from the game thread.
+		 */
+		virtual double getLatency() const {return 0.0;}
+	};
+
+	/**
+	 * Writes everything rendered to a 16 bit stereo WAV file as fast as possible.
+	 */
+	class MixerSinkFile : public MixerSink {
+	public:
+		explicit MixerSinkFile(const std::string& path);
+		~MixerSinkFile() override;
+
+		void write(const int16_t* samples, size_t frames) override;
+		bool isOpen() const {return static_cast<bool>(_file);}
+
+	private:
+		std::ofstream _file;
+		uint32_t _bytes = 0;
+	};
+
+	/**
+	 * Software mixer for sound effects and the BGM. The game thread only ever
+	 * enqueues commands, everything else happens on the mixer thread (or
+	 * inside of render if it is being driven by hand, like in a headless test).
+	 */
+	class Mixer {
+	public:
+		static constexpr unsigned int RATE = 44100;
+		static constexpr unsigned int CHANNELS = 2;
+		static constexpr size_t BLOCK_FRAMES = 512;
+		static constexpr int MAX_VOICES = 16;
+		static constexpr unsigned int MAX_STREAM_RATIO = 4; // Streams can be at most 4x RATE
+
+		// How many copies of one sound effect can be heard at once
+		static constexpr int DEFAULT_POLYPHONY = 2;
+
+		Mixer();
+		Mixer(Mixer&) = delete;
+		~Mixer();
+
+		/**
+		 * Game thread. Each returns false if the command queue was full and the
+		 * command was dropped, takeDropped counts those.
+		 */
+		bool playSFX(std::shared_ptr<const Pcm> pcm, int polyphony);
+		bool playStream(std::shared_ptr<MixerStream> stream, bool loop);
+		bool pauseStream(std::shared_ptr<MixerStream> stream);
+		bool stopStream(std::shared_ptr<MixerStream> stream);
+		bool setStreamLoop(std::shared_ptr<MixerStream> stream, bool loop);
+
+		/**
+		 * Game thread. Commands dropped since the last call.
+		 */
+		uint32_t takeDropped();
+
+		/**
+		 * Frees anything the mixer thread is finished with. Call it once in a while
+		 * from the game thread so that the mixer never has to free memory itself.
+		 */
+		void collect();
+
+		/**
+		 * Starts a thread that renders blocks into the sink until stop is called.
+		 */
+		void start(MixerSink& sink);
+		void stop();
+
+		/**
+		 * Output latency of the sink the mixer thread is rendering into.
+		 */
+		double getLatency() const;
+
+		/**
+		 * Sound effects and streams that were heard in the last block rendered.
+		 */
+		int getPlaying() const {return _playing.load(std::memory_order_relaxed);}
+
+		/**
+		 * Processes commands and mixes frames of interleaved stereo audio into out.
+		 * Only call this from one thread at a time, and not while the thread is running.
+		 */
+		void render(int16_t* out, size_t frames);
+
+	private:
+		enum class Op {
+			NONE,
+			PLAY,
+			PAUSE,
+			STOP,
+			LOOP
+		};
+
+		struct Command {
+			Op op = Op::NONE;
+			bool loop = false;
+			int polyphony = 0;
+			std::shared_ptr<const Pcm> pcm;
+			std::shared_ptr<MixerStream> stream;
+		};
+
+		struct Voice {
+			std::shared_ptr<const Pcm> pcm;
+			uint64_t position = 0; // 16.16 fixed point, in source frames
+			uint64_t started = 0;
+		};
+
+		bool push(Command&& command);
+		void process(Command& command);
+		void retire(std::shared_ptr<const void> resource);
+		void mixVoices(int32_t* out, size_t frames);
+		void mixStream(int32_t* out, size_t frames);
+		void run(MixerSink& sink);
+
+		Queue<Command, 64> _commands;
+		Queue<std::shared_ptr<const void>, 64> _retired;
+		uint32_t _dropped = 0; // Game thread
+
+		// Mixer thread state
+		std::array<Voice, MAX_VOICES> _voices{};
+		uint64_t _started = 0;
+		std::shared_ptr<MixerStream> _stream;
+		bool _streamPlaying = false;
+		bool _streamLoop = false;
+		uint32_t _streamPhase = 0; // 16.16 fixed point, always less than one frame
+		std::array<int16_t, CHANNELS> _streamFrame{};
+		std::vector<int16_t> _decoded;
+		std::vector<int32_t> _accumulator;
+
+		std::atomic<bool> _running{false};
+		std::atomic<int> _playing{0};
+		std::atomic<MixerSink*> _sink{nullptr};
+		std::thread _thread;
+	};
+}
+
+#endif //SUPER_HAXAGON_MIXER_HPP
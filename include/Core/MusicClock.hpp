@@ -0,0 +1,40 @@
+#ifndef SUPER_HAXAGON_MUSIC_CLOCK_HPP
+#define SUPER_HAXAGON_MUSIC_CLOCK_HPP
+
+namespace SuperHaxagon {
+	/**
+	 * Turns the position reported by an audio output into a smooth clock.
+	 *
+	 * Outputs only report how many samples they have consumed once per buffer,
+	 * which can be anywhere from a few to a couple hundred milliseconds. Between
+	 * reports the clock runs off of the platform's monotonic timer, but never more
+	 * than one buffer ahead of the last report, and it never runs backwards unless
+	 * the music itself jumped (for example, it looped).
+	 */
+	class MusicClock {
+	public:
+		/**
+		 * position is where the output is, in seconds, and now is any monotonic
+		 * time in seconds. granularity is the longest the output can go without
+		 * reporting a new position. Call while the music is playing.
+		 */
+		double update(double position, double now, double granularity);
+
+		/**
+		 * The last time returned by update, for when the music is paused.
+		 */
+		double get() const {return _last;}
+
+		/**
+		 * Forget everything, for when the music starts over from the beginning.
+		 */
+		void reset();
+
+	private:
+		double _position = -1.0;
+		double _anchor = 0.0;
+		double _last = 0.0;
+	};
+}
+
+#endif //SUPER_HAXAGON_MUSIC_CLOCK_HPP
@@ -0,0 +1,79 @@
+#ifndef SUPER_HAXAGON_QUALITY_HPP
+#define SUPER_HAXAGON_QUALITY_HPP
+
+#include <cstddef>
+
+namespace SuperHaxagon {
+	/**
+	 * Picks how expensive frames can be to keep up a target frame rate. Levels
+	 * go from 0, the best looking, to getLevels() - 1, the cheapest, and it's up
+	 * to the driver what they mean.
+	 *
+	 * Slow frames step down quickly. Frame times can't show how much headroom
+	 * there is when vsync is on, so going back up is a probe: after holding the
+	 * target for a while the next level up is tried, and if that turns out too
+	 * slow the wait before the next try doubles. That way it doesn't flicker
+	 * between two levels when only one of them fits.
+	 */
+	class QualityController {
+	public:
+		/**
+		 * target is in seconds per frame.
+		 */
+		QualityController(double target, size_t levels);
+
+		/**
+		 * Call once a frame with how long the last frame took, in seconds.
+		 * Returns true if getLevel changed.
+		 */
+		bool update(double frame);
+
+		size_t getLevel() const {return _level;}
+		size_t getLevels() const {return _levels;}
+		double getTarget() const {return _target;}
+
+		/**
+		 * For when the rate being aimed for changes, such as the window moving
+		 * to another display. Where the level is stays as it is.
+		 */
+		void setTarget(double target) {_target = target;}
+
+		/**
+		 * Smoothed frame time, in seconds.
+		 */
+		double getAverage() const {return _average;}
+
+	private:
+		// How much of the newest frame goes into the average
+		static constexpr double SMOOTHING = 0.1;
+
+		// Averages over target * SLOW are too slow, up to target * HOLD is on target
+		static constexpr double SLOW = 1.15;
+		static constexpr double HOLD = 1.05;
+
+		// Frames in a row before stepping down
+		static constexpr int SLOW_FRAMES = 20;
+
+		// Frames ignored after a change, it often hitches while things get recreated
+		static constexpr int SETTLE_FRAMES = 30;
+
+		// Frames on target before trying a better level, doubled on every failed try
+		static constexpr int PROBE_FRAMES = 300;
+		static constexpr int PROBE_FRAMES_MAX = PROBE_FRAMES * 32;
+
+		bool change(size_t level);
+
+		double _target;
+		size_t _levels;
+		size_t _level = 0;
+
+		double _average;
+		int _slow = 0;
+		int _hold = 0;
+		int _settle = SETTLE_FRAMES;
+		int _probe = PROBE_FRAMES;
+		bool _probing = false;
+	};
+}
+
+#endif //SUPER_HAXAGON_QUALITY_HPP
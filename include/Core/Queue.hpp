@@ -0,0 +1,63 @@
+#ifndef SUPER_HAXAGON_QUEUE_HPP
+#define SUPER_HAXAGON_QUEUE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace SuperHaxagon {
+
+	/**
+	 * Fixed size, lock-free queue for exactly one producer thread and one
+	 * consumer thread. Slots are preallocated, so pushing and popping never
+	 * allocate (as long as T's move doesn't).
+	 */
+	template<class T, size_t N>
+	class Queue {
+	public:
+		static_assert(N >= 2 && (N & (N - 1)) == 0, "queue size must be a power of two");
+
+		/**
+		 * Producer only. Returns false (and leaves value alone) if the queue is full.
+		 */
+		bool push(T&& value) {
+			const auto head = _head.load(std::memory_order_relaxed);
+			const auto next = (head + 1) & (N - 1);
+			if (next == _tail.load(std::memory_order_acquire)) return false;
+			_items[head] = std::move(value);
+			_head.store(next, std::memory_order_release);
+			return true;
+		}
+
+		/**
+		 * Consumer only. Returns false if there was nothing to pop.
+		 */
+		bool pop(T& out) {
+			const auto tail = _tail.load(std::memory_order_relaxed);
+			if (tail == _head.load(std::memory_order_acquire)) return false;
+			out = std::move(_items[tail]);
+			_tail.store((tail + 1) & (N - 1), std::memory_order_release);
+			return true;
+		}
+
+		bool empty() const {
+			return _tail.load(std::memory_order_acquire) == _head.load(std::memory_order_acquire);
+		}
+
+		/**
+		 * Safe from either thread, but only a snapshot.
+		 */
+		size_t size() const {
+			return (_head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire)) & (N - 1);
+		}
+
+	private:
+		std::array<T, N> _items{};
+
+		// Kept on separate cache lines so both threads don't fight over one
+		alignas(64) std::atomic<size_t> _head{0};
+		alignas(64) std::atomic<size_t> _tail{0};
+	};
+}
+
+#endif //SUPER_HAXAGON_QUEUE_HPP
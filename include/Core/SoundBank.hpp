@@ -0,0 +1,64 @@
+#ifndef SUPER_HAXAGON_SOUND_BANK_HPP
+#define SUPER_HAXAGON_SOUND_BANK_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace SuperHaxagon {
+	class Platform;
+
+	// Every sound effect in the game. Each one is loaded from /sound/<name>.wav.
+	enum class SoundId : uint8_t {
+		BEGIN,
+		HEXAGON,
+		OVER,
+		SELECT,
+		LEVEL_UP,
+		WONDERFUL,
+		LAST // Unused, but used for iteration
+	};
+
+	/**
+	 * All of the sound effects, decoded to 16 bit PCM and packed one after
+	 * another into a single allocation. Files are decoded in parallel.
+	 */
+	class SoundBank {
+	public:
+		using Arena = std::unique_ptr<int16_t[], void(*)(int16_t*)>;
+
+		struct Sound {
+			const int16_t* samples = nullptr; // Interleaved, points into the arena
+			size_t frames = 0;
+			uint16_t channels = 0;
+			uint32_t rate = 0;
+		};
+
+		/**
+		 * Loads every sound effect. If rate or channels are not 0, sounds are
+		 * converted to that format while they are decoded, for outputs that
+		 * can't do it themselves.
+		 */
+		explicit SoundBank(Platform& platform, uint32_t rate = 0, uint16_t channels = 0);
+		SoundBank(SoundBank&) = delete;
+		~SoundBank();
+
+		/**
+		 * Sounds that failed to load have no samples and zero frames.
+		 */
+		const Sound& get(const SoundId id) const {return _sounds[static_cast<size_t>(id)];}
+
+		/**
+		 * Size of the arena in bytes.
+		 */
+		size_t getMemoryUsage() const {return _bytes;}
+
+	private:
+		Arena _arena;
+		size_t _bytes = 0;
+		std::array<Sound, static_cast<size_t>(SoundId::LAST)> _sounds{};
+	};
+}
+
+#endif //SUPER_HAXAGON_SOUND_BANK_HPP
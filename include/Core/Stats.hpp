@@ -0,0 +1,96 @@
+#ifndef SUPER_HAXAGON_STATS_HPP
+#define SUPER_HAXAGON_STATS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace SuperHaxagon {
+	enum class Stat : uint8_t {
+		POLYGONS, // Every drawPoly and drawStrip
+		TRIANGLES,
+		VERTICES,
+		DRAW_CALLS, // Batches handed to the graphics API, software drivers have none
+		TEXT_DRAWS,
+		STATE_TRANSITIONS,
+		PATTERN_SPAWNS,
+		PATTERN_RETIREMENTS,
+		LIVE_WALLS, // Set, not added to
+		AUDIO_VOICES, // Set, not added to
+		LAST // Unused, but used for iteration
+	};
+
+	/**
+	 * Counts what went into a frame, so that a slow frame can be matched up
+	 * with what it was doing. Only touch it from the game thread, counting
+	 * is just an add into an array.
+	 *
+	 * Game ends every frame, drawn or not, which moves the counts into
+	 * getLast and into the running averages and peaks.
+	 */
+	class Stats {
+	public:
+		static constexpr size_t COUNT = static_cast<size_t>(Stat::LAST);
+		using Frame = std::array<uint64_t, COUNT>;
+
+		void add(const Stat stat, const uint64_t amount = 1) {_current[static_cast<size_t>(stat)] += amount;}
+		void set(const Stat stat, const uint64_t value) {_current[static_cast<size_t>(stat)] = value;}
+
+		/**
+		 * One polygon or strip of points, counted as the triangles it becomes.
+		 */
+		void addPoly(const size_t points) {
+			if (points < 3) return;
+			add(Stat::POLYGONS);
+			add(Stat::TRIANGLES, points - 2);
+			add(Stat::VERTICES, points);
+		}
+
+		/**
+		 * Returns true when a report is due, every setPeriod frames.
+		 */
+		bool endFrame();
+
+		/**
+		 * Frames between reports, 0 to never have one due.
+		 */
+		void setPeriod(const uint64_t frames) {_period = frames;}
+
+		const Frame& getLast() const {return _last;}
+
+		/**
+		 * The last frame as overlay lines, a few counters to a line.
+		 */
+		void getLines(std::vector<std::string>& lines) const;
+
+		/**
+		 * Averages and peaks since the last report, then starts a new one.
+		 */
+		std::string getReport();
+
+		/**
+		 * Averages and peaks over every frame so far.
+		 */
+		std::string getSummary() const;
+
+	private:
+		struct Window {
+			Frame total{};
+			Frame peak{};
+			uint64_t frames = 0;
+		};
+
+		static void add(Window& window, const Frame& frame);
+		static std::string describe(const Window& window);
+
+		Frame _current{};
+		Frame _last{};
+		Window _report;
+		Window _run;
+		uint64_t _period = 0;
+	};
+}
+
+#endif //SUPER_HAXAGON_STATS_HPP
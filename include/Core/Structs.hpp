@@ -20,6 +20,30 @@ namespace SuperHaxagon {
 		double y;
 	};
 
+	/**
+	 * A 2D affine transform. A point ends up at
+	 * (xx * x + xy * y + tx, yx * x + yy * y + ty).
+	 */
+	struct Transform {
+		double xx;
+		double xy;
+		double tx;
+		double yx;
+		double yy;
+		double ty;
+	};
+
+	/**
+	 * Where the background triangles go. They fan out from focus to
+	 * distance, then go through the platform's transform like every other shape.
+	 */
+	struct BackgroundTransform {
+		Point focus;
+		double distance;
+		double rotation;
+		double sides;
+	};
+
 	enum class Movement {
 		CAN_MOVE,
 		CANNOT_MOVE_LEFT,
@@ -60,6 +84,8 @@ namespace SuperHaxagon {
 	static const Color COLOR_BLACK =  {0, 0, 0, 0xFF};
 	static const Color COLOR_RED =  {0xFF, 0x60, 0x60, 0xFF};
 
+	static const Transform TRANSFORM_IDENTITY = {1, 0, 0, 0, 1, 0};
+
 	static const Color PULSE_LOW = {0xFF, 0xFF, 0xFF, 0x7F};
 	static const Color PULSE_HIGH = {0xFF, 0xFF, 0xFF, 0xFF};
 
@@ -83,6 +109,27 @@ namespace SuperHaxagon {
 	 */
 	Point rotateAroundOrigin(const Point& point, double rotation);
 
+	/**
+	 * Moves a point through a transform
+	 */
+	Point transformPoint(const Transform& transform, const Point& point);
+
+	/**
+	 * A transform that does inner first, then outer
+	 */
+	Transform combine(const Transform& outer, const Transform& inner);
+
+	/**
+	 * A transform that moves every point by offset
+	 */
+	Transform translate(const Point& offset);
+
+	/**
+	 * Writes the transform that undoes transform into inverse.
+	 * Returns false if there isn't one, like when everything is squished flat.
+	 */
+	bool invert(const Transform& transform, Transform& inverse);
+
 	/**
 	 * Converts score into a string
 	 *
@@ -91,6 +138,12 @@ namespace SuperHaxagon {
 	 */
 	std::string getTime(double score);
 
+	/**
+	 * Same as getTime, but written into buffer (including the null terminator)
+	 * without allocating. Returns how many characters were written.
+	 */
+	size_t formatTime(char* buffer, size_t size, double score);
+
 	/**
 	 * Will pulse between 0.0 and 1.0 at the speed given (in tenths of a second).
 	 * start is when the pulse should (have) start(ed).
@@ -0,0 +1,59 @@
+#ifndef SUPER_HAXAGON_TRACE_HPP
+#define SUPER_HAXAGON_TRACE_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+/**
+ * Scoped timing zones that are written out as a Chrome trace_event file,
+ * which Perfetto and chrome://tracing can both open. Every thread records
+ * into its own buffer that only keeps the last TRACE_EVENTS zones.
+ *
+ * Zones only exist when built with SUPER_HAXAGON_TRACE defined, otherwise
+ * the macros expand to nothing and there is no cost at all.
+ *
+ * TRACE_ZONE("name") times from where it is to the end of its scope.
+ * TRACE_THREAD("name") names the calling thread in the trace.
+ * Both only keep the pointer, so names have to be string literals.
+ */
+#ifdef SUPER_HAXAGON_TRACE
+#define TRACE_JOIN_INNER(a, b) a##b
+#define TRACE_JOIN(a, b) TRACE_JOIN_INNER(a, b)
+#define TRACE_ZONE(name) const SuperHaxagon::TraceZone TRACE_JOIN(traceZone, __LINE__)(name)
+#define TRACE_THREAD(name) SuperHaxagon::setTraceThread(name)
+#else
+#define TRACE_ZONE(name) do {} while (false)
+#define TRACE_THREAD(name) do {} while (false)
+#endif
+
+namespace SuperHaxagon {
+	static constexpr size_t TRACE_EVENTS = 1 << 16;
+
+	/**
+	 * Writes every thread's zones to path. Safe to call while other threads are
+	 * still recording. Returns false if the file couldn't be written.
+	 */
+	bool writeTrace(const std::string& path);
+
+	/**
+	 * Use TRACE_THREAD instead, so that it goes away with tracing off.
+	 */
+	void setTraceThread(const char* name);
+
+	/**
+	 * Use TRACE_ZONE instead, so that it goes away with tracing off.
+	 */
+	class TraceZone {
+	public:
+		explicit TraceZone(const char* name) : _name(name), _start(std::chrono::steady_clock::now()) {}
+		TraceZone(TraceZone&) = delete;
+		~TraceZone();
+
+	private:
+		const char* _name;
+		std::chrono::steady_clock::time_point _start;
+	};
+}
+
+#endif //SUPER_HAXAGON_TRACE_HPP
@@ -24,7 +24,8 @@ namespace SuperHaxagon {
 		std::unique_ptr<Audio> loadAudio(const std::string& path, SuperHaxagon::Stream stream) override;
 		std::unique_ptr<Font> loadFont(const std::string& path, int size) override;
 
-		void playSFX(Audio& audio) override;
+		SoundBank::Arena allocSFX(size_t samples) override;
+		void playSFX(SoundId id) override;
 		void playBGM(Audio& audio) override;
 
 		std::string getButtonName(const Buttons& button) override;
@@ -34,6 +35,7 @@ namespace SuperHaxagon {
 		void screenBegin() override;
 		void screenSwap() override;
 		void screenFinalize() override;
+		void screenSkip() override;
 		void drawPoly(const Color& color, const std::vector<Point>& points) override;
 
 		std::unique_ptr<Twist> getTwister() override;
@@ -41,12 +43,18 @@ namespace SuperHaxagon {
 		void shutdown() override;
 
 		void message(Dbg dbg, const std::string& where, const std::string& message) override;
+		void vmessage(Dbg dbg, const char* where, const char* format, va_list args) override;
 
 	private:
+		void keep(Dbg dbg, const std::string& line, bool last);
+
 		std::unique_ptr<Player> _sfx[MAX_TRACKS]{};
 
 		std::deque<std::pair<Dbg, std::string>> _messages{};
 
+		// Its sink fills _messages, so it has to be stopped before they're destroyed
+		Log _log{"3ds", [this](const Dbg dbg, const std::string& line, const bool last) {keep(dbg, line, last);}};
+
 		C3D_RenderTarget* _top = nullptr;
 		C3D_RenderTarget* _bot = nullptr;
 		C2D_TextBuf _buff;
@@ -1,6 +1,7 @@
 #ifndef SUPER_HAXAGON_PLAYER_OGG_3DS_HPP
 #define SUPER_HAXAGON_PLAYER_OGG_3DS_HPP
 
+#include "Core/MusicClock.hpp"
 #include "Driver/Player.hpp"
 
 #include <3ds.h>
@@ -17,6 +18,10 @@ namespace SuperHaxagon {
 		static constexpr int THREAD_AFFINITY = -1;
 		static constexpr int THREAD_STACK_SZ = 32 * 1024;
 
+		// The DSP mixes 160 samples at a time at ~32728 Hz, which is also
+		// how often the channel's sample position moves forward.
+		static constexpr double DSP_FRAME = 160.0 / 32728.0;
+
 		explicit PlayerOgg3DS(const std::string& path);
 		~PlayerOgg3DS() override;
 
@@ -30,6 +35,7 @@ namespace SuperHaxagon {
 		void pause() override;
 		bool isDone() const override;
 		double getTime() const override;
+		double getLatency() const override;
 
 	private:
 		static bool audioDecode(stb_vorbis* file, ndspWaveBuf* buff, int channel);
@@ -43,12 +49,14 @@ namespace SuperHaxagon {
 		int16_t* _audioBuffer = nullptr;
 		stb_vorbis* _oggFile = nullptr;
 		std::array<ndspWaveBuf, 3> _waveBuffs{};
+		std::array<uint64_t, 3> _waveBuffStart{}; // Frame of the song each buffer starts at
+		uint64_t _decoded = 0; // Only touched by the audio thread
+		bool _playing = false;
+		mutable MusicClock _clock;
 		volatile bool _loaded = false;   // if data is loaded
 		volatile bool _loop = false;     // if audio should loop
 		volatile bool _quit = false;     // if thread should be shut down
 		volatile int _channel = 0;
-		volatile uint64_t _start = 0;
-		volatile uint64_t _diff = 0;
 	};
 }
 
@@ -18,6 +18,7 @@ namespace SuperHaxagon {
 		void pause() override {};
 		bool isDone() const override;
 		double getTime() const override;
+		double getLatency() const override {return 0;}
 
 	private:
 		u8* _data;
@@ -0,0 +1,55 @@
+#ifndef SUPER_HAXAGON_BACKGROUND_TARGET_HPP
+#define SUPER_HAXAGON_BACKGROUND_TARGET_HPP
+
+#include "../../Core/Structs.hpp"
+#include "RenderTarget.hpp"
+
+#include <vector>
+
+namespace SuperHaxagon {
+	/**
+	 * Draws the background as one full screen quad. The fragment shader works
+	 * out which of Game::drawBackground's triangles a pixel would have been in,
+	 * so every pixel is only filled once instead of once per overlapping shape.
+	 */
+	class BackgroundTarget {
+	public:
+		explicit BackgroundTarget(Platform& platform);
+		BackgroundTarget(BackgroundTarget&) = delete;
+		~BackgroundTarget();
+
+		/**
+		 * inverse undoes the platform's transform, it takes a pixel back to where the triangles are built.
+		 */
+		void insert(const Color& color1, const Color& color2, const Color& color3, const BackgroundTransform& transform, const Transform& inverse, uint16_t z);
+		void draw(Platform& platform);
+
+	private:
+		struct Batch {
+			Color color1;
+			Color color2;
+			Color color3;
+			BackgroundTransform transform;
+			Transform inverse;
+			uint16_t z;
+		};
+
+		std::vector<Batch> _batches;
+
+		GLuint _program = 0;
+		GLuint _vao = 0;
+
+		GLint _uniformScreen = -1;
+		GLint _uniformFocus = -1;
+		GLint _uniformDistance = -1;
+		GLint _uniformRotation = -1;
+		GLint _uniformSides = -1;
+		GLint _uniformInverse = -1;
+		GLint _uniformZ = -1;
+		GLint _uniformColor1 = -1;
+		GLint _uniformColor2 = -1;
+		GLint _uniformColor3 = -1;
+	};
+}
+
+#endif //SUPER_HAXAGON_BACKGROUND_TARGET_HPP
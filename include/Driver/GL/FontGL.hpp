@@ -0,0 +1,36 @@
+#ifndef SUPER_HAXAGON_FONT_GL_HPP
+#define SUPER_HAXAGON_FONT_GL_HPP
+
+#include "../../Driver/Font.hpp"
+
+#include "../../Core/GlyphAtlas.hpp"
+#include "../../Core/Structs.hpp"
+#include "RenderTarget.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace SuperHaxagon {
+	class PlatformGL;
+
+	class FontGL : public Font {
+	public:
+		FontGL(PlatformGL& platform, const std::string& path, double size);
+		~FontGL() override;
+
+		void setScale(double) override {};
+		double getHeight() const override;
+		double getWidth(const std::string& text) const override;
+		void draw(const Color& color, const Point& position, Alignment alignment, const std::string& text) override;
+
+	private:
+		PlatformGL& _platform;
+
+		GlyphAtlas _atlas;
+		std::vector<GlyphAtlas::Quad> _quads;
+
+		std::shared_ptr<RenderTarget<VertexUV>> _surface;
+	};
+}
+
+#endif //SUPER_HAXAGON_FONT_GL_HPP
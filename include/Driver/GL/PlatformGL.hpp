@@ -0,0 +1,86 @@
+#ifndef SUPER_HAXAGON_PLATFORM_GL_HPP
+#define SUPER_HAXAGON_PLATFORM_GL_HPP
+
+#include "../../Driver/Platform.hpp"
+
+#include "BackgroundTarget.hpp"
+#include "RenderTarget.hpp"
+#include "WallTarget.hpp"
+
+#include <EGL/egl.h>
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+
+namespace SuperHaxagon {
+	/**
+	 * Everything an OpenGL 3.3 core driver shares: the EGL context, the
+	 * render targets and the z counter. Polygons and text are batched into
+	 * one draw call per render target, opaque targets first.
+	 */
+	class PlatformGL : public Platform {
+	public:
+		explicit PlatformGL(Dbg dbg);
+		PlatformGL(PlatformGL&) = delete;
+		~PlatformGL() override;
+
+		std::unique_ptr<Font> loadFont(const std::string& path, int size) override;
+		Point getScreenDim() const override;
+
+		void screenBegin() override;
+		void screenSwap() override;
+		void screenFinalize() override;
+		void drawPoly(const Color& color, const std::vector<Point>& points) override;
+		bool drawStrip(const Color& color, const std::vector<Point>& points) override;
+		bool drawWalls(const Color& color, const WallTransform& transform, const std::vector<WallInstance>& walls) override;
+		bool drawBackground(const Color& color1, const Color& color2, const Color& color3, const BackgroundTransform& transform) override;
+
+		/**
+		 * Every draw gets its own depth, later draws are in front. Saturates
+		 * after 65535 draws in one frame, at which point they start to overlap.
+		 */
+		uint16_t getAndIncrementZ();
+		void addRenderTarget(std::shared_ptr<RenderTarget<Vertex>>& target) {_targetVertex.emplace_back(target);}
+		void addRenderTarget(std::shared_ptr<RenderTarget<VertexUV>>& target) {_targetVertexUV.emplace_back(target);}
+
+	protected:
+		/**
+		 * Creates a core profile context of at least major.minor on display. Renders
+		 * to window, or to an offscreen pbuffer that is _width by _height if window is 0.
+		 */
+		bool initGL(EGLDisplay display, EGLNativeWindowType window, int major, int minor);
+		void destroyGL();
+
+		unsigned int _width = 1280;
+		unsigned int _height = 720;
+
+		EGLDisplay _display = EGL_NO_DISPLAY;
+		EGLContext _context = EGL_NO_CONTEXT;
+		EGLSurface _surface = EGL_NO_SURFACE;
+
+		// Turn off to build walls on the CPU, for comparing against the instanced path
+		bool _instancedWalls = true;
+
+		// Same, but for drawing the background as triangles
+		bool _shaderBackground = true;
+
+	private:
+		template<class T>
+		void render(const std::deque<std::shared_ptr<RenderTarget<T>>>& targets, bool transparent);
+
+		bool _offscreen = false;
+		uint16_t _z = 0;
+
+		std::shared_ptr<RenderTarget<Vertex>> _opaque;
+		std::shared_ptr<RenderTarget<Vertex>> _transparent;
+		std::unique_ptr<WallTarget> _opaqueWalls;
+		std::unique_ptr<WallTarget> _transparentWalls;
+		std::unique_ptr<BackgroundTarget> _background;
+
+		std::deque<std::shared_ptr<RenderTarget<Vertex>>> _targetVertex{};
+		std::deque<std::shared_ptr<RenderTarget<VertexUV>>> _targetVertexUV{};
+	};
+}
+
+#endif //SUPER_HAXAGON_PLATFORM_GL_HPP
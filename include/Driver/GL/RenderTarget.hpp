@@ -0,0 +1,132 @@
+#ifndef SUPER_HAXAGON_RENDER_TARGET_HPP
+#define SUPER_HAXAGON_RENDER_TARGET_HPP
+
+#include "../../Core/Structs.hpp"
+
+#ifdef __SWITCH__
+#include <glad/glad.h>
+#else
+// Desktop drivers link straight against libOpenGL, which exports the whole core profile
+#define GL_GLEXT_PROTOTYPES
+#include <GL/glcorearb.h>
+#endif
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace SuperHaxagon {
+	// Smallest a streaming buffer will ever be, in bytes
+	static constexpr size_t BUFFER_MIN_SIZE = 16 * 1024;
+
+	// Streaming buffers hold this many frames before they are orphaned
+	static constexpr size_t BUFFER_FRAMES = 4;
+
+	/**
+	 * 16 bytes. z is normalized, so 0xFFFF is the very front.
+	 */
+	struct Vertex {
+		Vertex(const Point& p, const Color& c, const uint16_t z) :
+			x(static_cast<float>(p.x)), y(static_cast<float>(p.y)), c(c), z(z) {}
+
+		float x;
+		float y;
+		Color c;
+		uint16_t z;
+	};
+
+	/**
+	 * 20 bytes. uv is normalized, so texture coordinates have to be between 0 and 1.
+	 */
+	struct VertexUV {
+		VertexUV(const Point& p, const Point& uv, const Color& c, const uint16_t z) :
+			x(static_cast<float>(p.x)), y(static_cast<float>(p.y)),
+			u(static_cast<uint16_t>(uv.x * 0xFFFF + 0.5)), v(static_cast<uint16_t>(uv.y * 0xFFFF + 0.5)),
+			c(c), z(z) {}
+
+		float x;
+		float y;
+		uint16_t u;
+		uint16_t v;
+		Color c;
+		uint16_t z;
+	};
+
+	/**
+	 * A buffer that is written to front to back, a frame at a time. When the
+	 * next frame doesn't fit it gets orphaned, so the driver can hand back
+	 * fresh memory while the GPU is still reading the old one.
+	 */
+	struct StreamBuffer {
+		GLenum type;
+		std::string label;
+		GLuint buffer = 0;
+		size_t capacity = 0;
+		size_t offset = 0;
+
+		/**
+		 * Copies data into the buffer, which has to be bound, and returns the byte
+		 * offset it landed at. The offset is always a multiple of align.
+		 */
+		size_t upload(Platform& platform, const void* data, size_t bytes, size_t align);
+	};
+
+	/**
+	 * Compiles one shader stage, logging why if it fails.
+	 */
+	GLuint compileShader(Platform& platform, GLenum type, const char* source);
+
+	/**
+	 * Compiles and links a program out of a vertex and a fragment shader.
+	 */
+	GLuint linkProgram(Platform& platform, const char* shaderVertex, const char* shaderFragment);
+
+	/**
+	 * Sets a mat3 uniform of the program in use, so (m * vec3(p, 1.0)).xy transforms p.
+	 */
+	void uploadTransform(GLint uniform, const Transform& transform);
+
+	template<class T>
+	class RenderTarget {
+	public:
+		RenderTarget<T>(Platform& platform, bool transparent, const std::string& shaderVertex, const std::string& shaderFragment, std::string label);
+		~RenderTarget<T>();
+
+		void bind() const;
+		void insert(const T& vertex);
+		void reference(unsigned int index);
+		void advance(unsigned int indices);
+		void draw(Platform& platform);
+		bool isTransparent() const {return _transparent;}
+
+	private:
+		void init(Platform& platform, const char* shaderVertex, const char* shaderFragment);
+
+		const std::string _label;
+
+		bool _transparent;
+		unsigned int _iboLastIndex = 0;
+
+		std::vector<T> _vertices;
+
+		// Opaque polygons have to be drawn front to back, but the engine adds them
+		// back to front. Their indices are collected per polygon and then put in
+		// front of everything before them, so the buffer is always in draw order.
+		std::vector<unsigned int> _indices;
+		std::vector<unsigned int> _polygon;
+		size_t _first = 0;
+
+		StreamBuffer _vbo{GL_ARRAY_BUFFER, {}};
+		StreamBuffer _ibo{GL_ELEMENT_ARRAY_BUFFER, {}};
+
+		GLuint _program = 0;
+		GLuint _tex = 0;
+		GLuint _vao = 0;
+
+		GLint _uniformWidth = -1;
+		GLint _uniformHeight = -1;
+		Point _screen{};
+	};
+}
+
+#endif //SUPER_HAXAGON_RENDER_TARGET_HPP
@@ -0,0 +1,58 @@
+#ifndef SUPER_HAXAGON_WALL_TARGET_HPP
+#define SUPER_HAXAGON_WALL_TARGET_HPP
+
+#include "../../Factories/Wall.hpp"
+#include "RenderTarget.hpp"
+
+#include <vector>
+
+namespace SuperHaxagon {
+	/**
+	 * Draws runs of walls as instances of a single strip. Only the WallInstances
+	 * are uploaded, the vertex shader does what Wall::calcStrip and the platform's transform do
+	 * on the CPU. Every batch of walls is one instanced draw call.
+	 */
+	class WallTarget {
+	public:
+		WallTarget(Platform& platform, bool transparent);
+		WallTarget(WallTarget&) = delete;
+		~WallTarget();
+
+		void insert(const Color& color, const WallTransform& transform, const Transform& screen, uint16_t z, const std::vector<WallInstance>& walls);
+		void draw(Platform& platform);
+		bool isTransparent() const {return _transparent;}
+
+	private:
+		struct Batch {
+			Color color;
+			WallTransform transform;
+			Transform screen;
+			uint16_t z;
+			size_t first;
+			size_t count;
+			uint8_t longest;
+		};
+
+		bool _transparent;
+
+		std::vector<Batch> _batches;
+		std::vector<WallInstance> _walls;
+
+		StreamBuffer _vbo{GL_ARRAY_BUFFER, "walls"};
+
+		GLuint _program = 0;
+		GLuint _vao = 0;
+
+		GLint _uniformScreen = -1;
+		GLint _uniformFocus = -1;
+		GLint _uniformRotation = -1;
+		GLint _uniformSides = -1;
+		GLint _uniformOffset = -1;
+		GLint _uniformScale = -1;
+		GLint _uniformTransform = -1;
+		GLint _uniformZ = -1;
+		GLint _uniformColor = -1;
+	};
+}
+
+#endif //SUPER_HAXAGON_WALL_TARGET_HPP
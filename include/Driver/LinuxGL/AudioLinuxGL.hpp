@@ -0,0 +1,26 @@
+#ifndef SUPER_HAXAGON_AUDIO_LINUX_GL_HPP
+#define SUPER_HAXAGON_AUDIO_LINUX_GL_HPP
+
+#include "../../Driver/Audio.hpp"
+
+namespace SuperHaxagon {
+	class PlatformLinuxGL;
+
+	/**
+	 * The headless driver has no audio output, but the game still needs
+	 * the BGM to keep time. Only INDIRECT audio makes a player.
+	 */
+	class AudioLinuxGL : public Audio {
+	public:
+		AudioLinuxGL(PlatformLinuxGL& platform, Stream stream);
+		~AudioLinuxGL() override;
+
+		std::unique_ptr<Player> instantiate() override;
+
+	private:
+		PlatformLinuxGL& _platform;
+		Stream _stream;
+	};
+}
+
+#endif //SUPER_HAXAGON_AUDIO_LINUX_GL_HPP
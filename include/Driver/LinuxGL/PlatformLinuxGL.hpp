@@ -0,0 +1,65 @@
+#ifndef SUPER_HAXAGON_PLATFORM_LINUX_GL_HPP
+#define SUPER_HAXAGON_PLATFORM_LINUX_GL_HPP
+
+#include "../../Core/FramePacer.hpp"
+#include "../../Driver/GL/PlatformGL.hpp"
+
+#include <chrono>
+#include <cstdint>
+
+namespace SuperHaxagon {
+	/**
+	 * Renders through OpenGL 3.3 core into an offscreen EGL surface, so it runs
+	 * without a window or a GPU (Mesa's llvmpipe is enough). There is no input
+	 * and no audio output. Every frame is exactly one tick, so runs are repeatable.
+	 *
+	 * Set SUPER_HAXAGON_FRAMES to stop after that many frames, and
+	 * SUPER_HAXAGON_CPU_WALLS or SUPER_HAXAGON_CPU_BACKGROUND to draw
+	 * walls or the background as triangles built on the CPU. Set
+	 * SUPER_HAXAGON_FPS to pace frames like a real display would.
+	 */
+	class PlatformLinuxGL : public PlatformGL {
+	public:
+		static constexpr double FRAME_RATE = 60.0;
+
+		explicit PlatformLinuxGL(Dbg dbg);
+		PlatformLinuxGL(PlatformLinuxGL&) = delete;
+		~PlatformLinuxGL() override;
+
+		bool loop() override;
+		double getDilation() override;
+
+		std::string getPath(const std::string& partial) override;
+		std::string getPathRom(const std::string& partial) override;
+		std::unique_ptr<Audio> loadAudio(const std::string& path, Stream stream) override;
+
+		void playSFX(SoundId) override {};
+		void playBGM(Audio& audio) override;
+
+		std::string getButtonName(const Buttons& button) override;
+		Buttons getPressed() override;
+
+		void screenFinalize() override;
+		void screenSkip() override;
+
+		std::unique_ptr<Twist> getTwister() override;
+
+		void shutdown() override;
+		void message(Dbg dbg, const std::string& where, const std::string& message) override;
+		void vmessage(Dbg dbg, const char* where, const char* format, va_list args) override;
+
+		uint64_t getFrames() const {return _frames;}
+
+	private:
+		Log _log{"linuxgl", Log::console};
+
+		bool _loaded = false;
+		uint64_t _frames = 0;
+		uint64_t _skipped = 0;
+		uint64_t _maxFrames = 0;
+		std::chrono::steady_clock::time_point _start;
+		FramePacer _pacer{0};
+	};
+}
+
+#endif //SUPER_HAXAGON_PLATFORM_LINUX_GL_HPP
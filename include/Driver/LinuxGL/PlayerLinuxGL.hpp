@@ -0,0 +1,39 @@
+#ifndef SUPER_HAXAGON_PLAYER_LINUX_GL_HPP
+#define SUPER_HAXAGON_PLAYER_LINUX_GL_HPP
+
+#include "../../Driver/Player.hpp"
+
+#include <cstdint>
+
+namespace SuperHaxagon {
+	class PlatformLinuxGL;
+
+	/**
+	 * Silent music that plays for as many frames as the platform renders
+	 * while it is playing, so headless runs stay repeatable. Never finishes.
+	 */
+	class PlayerLinuxGL : public Player {
+	public:
+		explicit PlayerLinuxGL(PlatformLinuxGL& platform);
+		~PlayerLinuxGL() override;
+
+		void setChannel(int) override {};
+		void setLoop(bool) override {};
+
+		void play() override;
+		void pause() override;
+		bool isDone() const override {return false;}
+		double getTime() const override;
+		double getLatency() const override {return 0.0;}
+
+	private:
+		uint64_t getFrames() const;
+
+		PlatformLinuxGL& _platform;
+		bool _playing = false;
+		uint64_t _start = 0;  // Platform frame that the music would have started on
+		uint64_t _paused = 0; // Frames played before the last pause
+	};
+}
+
+#endif //SUPER_HAXAGON_PLAYER_LINUX_GL_HPP
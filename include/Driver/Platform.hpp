@@ -3,23 +3,23 @@
 
 #include "Audio.hpp"
 #include "Player.hpp"
+#include "../Core/Log.hpp"
+#include "../Core/SoundBank.hpp"
+#include "../Core/Stats.hpp"
+#include "../Core/Structs.hpp"
 
+#include <cstdarg>
 #include <memory>
+#include <new>
 #include <string>
 #include <vector>
 
 namespace SuperHaxagon {
-	struct Point;
-	struct Color;
+	struct WallInstance;
+	struct WallTransform;
 	class Twist;
 	class Font;
 
-	enum class Dbg {
-		INFO,
-		WARN,
-		FATAL
-	};
-
 	struct Buttons {
 		bool select : 1;
 		bool back : 1;
@@ -28,6 +28,14 @@ namespace SuperHaxagon {
 		bool right : 1;
 	};
 
+	/**
+	 * Which buttons are down after a change, and when it happened.
+	 */
+	struct InputEvent {
+		double time;
+		Buttons buttons;
+	};
+
 	class Platform {
 	public:
 		explicit Platform(const Dbg dbg) : _dbg(dbg) {}
@@ -42,28 +50,134 @@ namespace SuperHaxagon {
 		virtual std::unique_ptr<Audio> loadAudio(const std::string& path, Stream stream) = 0;
 		virtual std::unique_ptr<Font> loadFont(const std::string& path, int size) = 0;
 
-		virtual void playSFX(Audio& audio) = 0;
+		/**
+		 * Loads every sound effect into the sound bank. Drivers that need their
+		 * own handles to the samples should call this first, then build them.
+		 */
+		virtual void loadSFX() {_sounds = std::make_unique<SoundBank>(*this);}
+
+		/**
+		 * Memory the sound bank decodes into. Override if the audio hardware
+		 * can only read from certain memory.
+		 */
+		virtual SoundBank::Arena allocSFX(const size_t samples) {
+			return {new (std::nothrow) int16_t[samples], [](int16_t* data) {delete[] data;}};
+		}
+
+		const SoundBank* getSounds() const {return _sounds.get();}
+
+		virtual void playSFX(SoundId id) = 0;
 		virtual void playBGM(Audio& audio) = 0;
 		virtual void stopBGM() {_bgm = nullptr;}
 		virtual Player* getBGM() {return _bgm.get();}
 
 		virtual std::string getButtonName(const Buttons& button) = 0;
 		virtual Buttons getPressed() = 0;
+
+		/**
+		 * Replaces events with every button change since the last call, oldest first,
+		 * stamped in seconds on the getInputTime clock. Returns false if the driver
+		 * doesn't keep track of changes, then getPressed is all there is.
+		 */
+		virtual bool pollInput(std::vector<InputEvent>&) {return false;}
+		virtual double getInputTime() const {return 0.0;}
+
 		virtual Point getScreenDim() const = 0;
 
 		virtual void screenBegin() = 0;
 		virtual void screenSwap() = 0;
 		virtual void screenFinalize() = 0;
+
+		/**
+		 * Called instead of drawing when the game has nothing new to show. The last
+		 * frame stays up, and drivers that are paced by presenting should wait out
+		 * about a frame here so that the loop keeps polling input without spinning.
+		 */
+		virtual void screenSkip() {}
+
 		virtual void drawPoly(const Color& color, const std::vector<Point>& points) = 0;
 
+		/**
+		 * Everything drawn through drawPoly, drawStrip, drawWalls and drawBackground goes
+		 * through the transform on top of this stack, drivers apply it however is cheapest
+		 * for them. A pushed transform is applied to points before the ones under it.
+		 * Fonts aren't transformed.
+		 */
+		void pushTransform(const Transform& transform) {_transforms.push_back(combine(getTransform(), transform));}
+		void popTransform() {if (_transforms.size() > 1) _transforms.pop_back();}
+		const Transform& getTransform() const {return _transforms.back();}
+
+		/**
+		 * Draws a triangle strip, every point makes a triangle with the two before it.
+		 * Returning false makes the game draw every triangle through drawPoly instead.
+		 */
+		virtual bool drawStrip(const Color&, const std::vector<Point>&) {return false;}
+
+		/**
+		 * Draws a batch of wall runs that share a color and a transform, building
+		 * the strips however the driver likes. Returning false makes the game
+		 * build them on the CPU and draw them through drawPoly and drawStrip instead.
+		 */
+		virtual bool drawWalls(const Color&, const WallTransform&, const std::vector<WallInstance>&) {return false;}
+
+		/**
+		 * Draws the whole background: color1 everywhere, color2 on every other
+		 * triangle, and color3 on the last one if there is an odd number of them.
+		 * Returning false makes the game draw the triangles through drawPoly instead.
+		 */
+		virtual bool drawBackground(const Color&, const Color&, const Color&, const BackgroundTransform&) {return false;}
+
+		/**
+		 * Driver state worth seeing while the game runs, like frame times or
+		 * render quality. Every line added is drawn in the top left corner
+		 * over everything else, so leave it empty to hide the overlay.
+		 */
+		virtual void getDebugInfo(std::vector<std::string>&) {}
+
+		/**
+		 * What went into each frame. Drivers count what they draw, the game counts the rest.
+		 */
+		Stats& getStats() {return _stats;}
+
 		virtual std::unique_ptr<Twist> getTwister() = 0;
 
+		/**
+		 * Walls don't kill while this is true, so that a scripted run
+		 * can get as far into a level as it needs to.
+		 */
+		virtual bool isImmortal() {return false;}
+
 		virtual void shutdown() = 0;
+
+		/**
+		 * What main returns after shutdown, headless drivers can fail a run with it.
+		 */
+		virtual int getExitCode() {return 0;}
+
 		virtual void message(Dbg level, const std::string& where, const std::string& message) = 0;
 
+		/**
+		 * A printf style message, formatted straight into the log so that
+		 * nothing is allocated along the way. Prefer it for messages that
+		 * can come up every frame.
+		 */
+		SUPER_HAXAGON_PRINTF(4, 5) void messagef(const Dbg level, const char* where, const char* format, ...) {
+			va_list args;
+			va_start(args, format);
+			vmessage(level, where, format, args);
+			va_end(args);
+		}
+
+		virtual void vmessage(Dbg level, const char* where, const char* format, va_list args) = 0;
+
 	protected:
 		Dbg _dbg;
 		std::unique_ptr<Player> _bgm;
+		std::unique_ptr<SoundBank> _sounds;
+		Stats _stats;
+
+	private:
+		std::vector<Transform> _transforms{TRANSFORM_IDENTITY};
 	};
 }
 
@@ -13,7 +13,18 @@ namespace SuperHaxagon {
 		virtual void play() = 0;
 		virtual void pause() = 0;
 		virtual bool isDone() const = 0;
+
+		/**
+		 * Position of the audio that can be heard right now, in seconds. This comes
+		 * from how many samples the output has consumed with getLatency taken off,
+		 * so that effects synced to the music line up with what the player hears.
+		 */
 		virtual double getTime() const = 0;
+
+		/**
+		 * Estimate of how long it takes a sample to be heard once it is consumed.
+		 */
+		virtual double getLatency() const = 0;
 	};
 }
 
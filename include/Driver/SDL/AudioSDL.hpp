@@ -0,0 +1,25 @@
+#ifndef SUPER_HAXAGON_AUDIO_SDL_HPP
+#define SUPER_HAXAGON_AUDIO_SDL_HPP
+
+#include "../../Driver/Audio.hpp"
+
+#include <SDL2/SDL_mixer.h>
+
+#include <string>
+
+namespace SuperHaxagon {
+	class Platform;
+	class AudioSDL : public Audio {
+	public:
+		AudioSDL(Platform& platform, const std::string& path, Stream stream);
+		~AudioSDL() override;
+
+		std::unique_ptr<Player> instantiate() override;
+
+	private:
+		Mix_Music* _music = nullptr;
+		Mix_Chunk* _sfx = nullptr;
+	};
+}
+
+#endif //SUPER_HAXAGON_AUDIO_SDL_HPP
@@ -0,0 +1,35 @@
+#ifndef SUPER_HAXAGON_FONT_SDL_HPP
+#define SUPER_HAXAGON_FONT_SDL_HPP
+
+#include "../../Driver/Font.hpp"
+
+#include "../../Core/GlyphAtlas.hpp"
+
+#include <SDL2/SDL.h>
+
+#include <vector>
+
+namespace SuperHaxagon {
+	class PlatformSDL;
+
+	class FontSDL : public Font {
+	public:
+		FontSDL(PlatformSDL& platform, const std::string& path, double size);
+		~FontSDL() override;
+
+		void setScale(double) override {};
+		double getHeight() const override;
+		double getWidth(const std::string& text) const override;
+		void draw(const Color& color, const Point& position, Alignment alignment, const std::string& text) override;
+
+	private:
+		PlatformSDL& _platform;
+
+		GlyphAtlas _atlas;
+		std::vector<GlyphAtlas::Quad> _quads;
+
+		SDL_Texture* _texture = nullptr;
+	};
+}
+
+#endif //SUPER_HAXAGON_FONT_SDL_HPP
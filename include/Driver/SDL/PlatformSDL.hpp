@@ -0,0 +1,115 @@
+#ifndef SUPER_HAXAGON_PLATFORM_SDL_HPP
+#define SUPER_HAXAGON_PLATFORM_SDL_HPP
+
+#include "../Platform.hpp"
+#include "../../Core/FramePacer.hpp"
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_mixer.h>
+
+#if !SDL_VERSION_ATLEAST(2, 0, 18)
+#error "SDL 2.0.18 or newer is needed for SDL_RenderGeometry"
+#endif
+
+#include <array>
+#include <chrono>
+
+namespace SuperHaxagon {
+	/**
+	 * Desktop driver on SDL2 and SDL_mixer. A whole frame is collected into one
+	 * vertex array and one index array, split into a run every time the texture
+	 * changes, and every run is drawn with a single SDL_RenderGeometry.
+	 *
+	 * Works with any SDL render driver, SDL_RENDER_DRIVER=software included.
+	 * With SDL_VIDEODRIVER=dummy and SDL_AUDIODRIVER=dummy it runs without a
+	 * display or a sound card. Set SUPER_HAXAGON_FPS to cap the frame rate,
+	 * and SUPER_HAXAGON_VSYNC=0 to turn vsync off. Without vsync the cap
+	 * defaults to FRAME_RATE. SUPER_HAXAGON_FRAMES stops after that many frames.
+	 */
+	class PlatformSDL : public Platform {
+	public:
+		static constexpr double FRAME_RATE = 60.0;
+
+		explicit PlatformSDL(Dbg dbg);
+		PlatformSDL(PlatformSDL&) = delete;
+		~PlatformSDL() override;
+
+		bool loop() override;
+		double getDilation() override;
+
+		std::string getPath(const std::string& partial) override;
+		std::string getPathRom(const std::string& partial) override;
+		std::unique_ptr<Audio> loadAudio(const std::string& path, Stream stream) override;
+		std::unique_ptr<Font> loadFont(const std::string& path, int size) override;
+
+		void loadSFX() override;
+		void playSFX(SoundId id) override;
+		void playBGM(Audio& audio) override;
+
+		std::string getButtonName(const Buttons& button) override;
+		Buttons getPressed() override;
+		Point getScreenDim() const override;
+
+		void screenBegin() override;
+		void screenSwap() override;
+		void screenFinalize() override;
+		void screenSkip() override;
+		void drawPoly(const Color& color, const std::vector<Point>& points) override;
+		bool drawStrip(const Color& color, const std::vector<Point>& points) override;
+
+		/**
+		 * Only shows anything after F3 is pressed.
+		 */
+		void getDebugInfo(std::vector<std::string>& lines) override;
+
+		std::unique_ptr<Twist> getTwister() override;
+
+		void shutdown() override;
+		void message(Dbg dbg, const std::string& where, const std::string& message) override;
+		void vmessage(Dbg dbg, const char* where, const char* format, va_list args) override;
+
+		SDL_Renderer* getRenderer() const {return _renderer;}
+
+		/**
+		 * Starts a new run if texture isn't the one being drawn with. Returns the
+		 * index the next vertex pushed onto getVertices will have.
+		 */
+		int startBatch(SDL_Texture* texture);
+		std::vector<SDL_Vertex>& getVertices() {return _vertices;}
+		std::vector<int>& getIndices() {return _indices;}
+
+	private:
+		struct Run {
+			SDL_Texture* texture;
+			size_t start; // First index
+		};
+
+		Log _log{"sdl", Log::console};
+
+		bool _loaded = false;
+		bool _overlay = false;
+		double _delta = 0.0;
+		uint64_t _frames = 0;
+		uint64_t _maxFrames = 0;
+		std::chrono::steady_clock::time_point _start;
+		std::chrono::steady_clock::time_point _last;
+		FramePacer _pacer{0};
+
+		// Stands in for vsync on loops that skip presenting
+		FramePacer _idle{FRAME_RATE};
+
+		SDL_Window* _window = nullptr;
+		SDL_Renderer* _renderer = nullptr;
+		SDL_RendererInfo _info{};
+
+		std::vector<SDL_Vertex> _vertices;
+		std::vector<int> _indices;
+		std::vector<Run> _runs;
+		size_t _drawn = 0; // Runs drawn last frame, for the overlay
+
+		// Point into the sound bank, so they don't own their samples
+		std::array<Mix_Chunk*, static_cast<size_t>(SoundId::LAST)> _sfx{};
+	};
+}
+
+#endif //SUPER_HAXAGON_PLATFORM_SDL_HPP
@@ -0,0 +1,43 @@
+#ifndef SUPER_HAXAGON_PLAYER_MUS_SDL_HPP
+#define SUPER_HAXAGON_PLAYER_MUS_SDL_HPP
+
+#include "../../Core/MusicClock.hpp"
+#include "../../Driver/Player.hpp"
+
+#include <SDL2/SDL_mixer.h>
+
+#include <atomic>
+
+namespace SuperHaxagon {
+	class PlayerMusSDL : public Player {
+	public:
+		static constexpr int RATE = 44100;
+		static constexpr int BUFFER_FRAMES = 4096;
+
+		explicit PlayerMusSDL(Mix_Music* music);
+		~PlayerMusSDL() override;
+
+		// Registered with Mix_SetPostMix, counts the frames the device consumes while music plays
+		static void postMix(void*, Uint8*, int length);
+
+		void setChannel(int) override {};
+		void setLoop(bool loop) override;
+
+		void play() override;
+		void pause() override;
+		bool isDone() const override;
+		double getTime() const override;
+		double getLatency() const override;
+		double getNow() const;
+
+	private:
+		static std::atomic<uint64_t> _consumed;
+
+		bool _loop = false;
+		bool _playing = false;
+		Mix_Music* _music;
+		mutable MusicClock _clock;
+	};
+}
+
+#endif //SUPER_HAXAGON_PLAYER_MUS_SDL_HPP
@@ -0,0 +1,28 @@
+#ifndef SUPER_HAXAGON_PLAYER_SFX_SDL_HPP
+#define SUPER_HAXAGON_PLAYER_SFX_SDL_HPP
+
+#include "../../Driver/Player.hpp"
+
+#include <SDL2/SDL_mixer.h>
+
+namespace SuperHaxagon {
+	class PlayerSfxSDL : public Player {
+	public:
+		explicit PlayerSfxSDL(Mix_Chunk* sfx);
+		~PlayerSfxSDL() override;
+
+		void setChannel(int) override {};
+		void setLoop(bool) override {};
+
+		void play() override;
+		void pause() override {};
+		bool isDone() const override {return true;}
+		double getTime() const override {return 0.0;}
+		double getLatency() const override {return 0.0;}
+
+	private:
+		Mix_Chunk* _sfx;
+	};
+}
+
+#endif //SUPER_HAXAGON_PLAYER_SFX_SDL_HPP
@@ -3,22 +3,23 @@
 
 #include "../../../include/Driver/Audio.hpp"
 
-#include <SFML/Audio/Music.hpp>
-#include <SFML/Audio/SoundBuffer.hpp>
+#include <memory>
 
 namespace SuperHaxagon {
+	class Mixer;
+	class DecoderSFML;
 	class AudioSFML : public Audio {
 	public:
-		AudioSFML(const std::string& path, Stream stream);
+		AudioSFML(Mixer& mixer, const std::string& path, Stream stream);
 		~AudioSFML() override;
 
 		std::unique_ptr<Player> instantiate() override;
 
 	private:
+		Mixer& _mixer;
 		Stream _stream = Stream::NONE;
 
-		std::unique_ptr<sf::SoundBuffer> _buffer;
-		std::unique_ptr<sf::Music> _music;
+		std::shared_ptr<DecoderSFML> _decoder;
 	};
 }
 
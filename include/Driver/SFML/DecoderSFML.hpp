@@ -0,0 +1,31 @@
+#ifndef SUPER_HAXAGON_DECODER_SFML_HPP
+#define SUPER_HAXAGON_DECODER_SFML_HPP
+
+#include "../../../include/Core/Mixer.hpp"
+
+#include <SFML/Audio/InputSoundFile.hpp>
+
+namespace SuperHaxagon {
+	/**
+	 * Streams a sound file from disk for the mixer.
+	 */
+	class DecoderSFML : public MixerStream {
+	public:
+		DecoderSFML() = default;
+		~DecoderSFML() override = default;
+
+		bool open(const std::string& path);
+
+		unsigned int getChannels() const override {return _channels;}
+		unsigned int getRate() const override {return _rate;}
+		size_t read(int16_t* out, size_t frames) override;
+		void rewind() override;
+
+	private:
+		sf::InputSoundFile _file;
+		unsigned int _channels = 0;
+		unsigned int _rate = 0;
+	};
+}
+
+#endif //SUPER_HAXAGON_DECODER_SFML_HPP
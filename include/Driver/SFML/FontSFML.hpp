@@ -4,7 +4,11 @@
 #include "../../../include/Driver/Font.hpp"
 
 #include <SFML/Graphics/Font.hpp>
-#include <SFML/Graphics/Text.hpp>
+#include <SFML/Graphics/Rect.hpp>
+
+#include <array>
+#include <memory>
+#include <unordered_map>
 
 namespace SuperHaxagon {
 	class PlatformSFML;
@@ -20,11 +24,28 @@ namespace SuperHaxagon {
 		void draw(const Color& color, const Point& position, Alignment alignment, const std::string& text) override;
 
 	private:
+		// Everything needed to lay out and draw one character, in pixels
+		struct Glyph {
+			float advance = 0;
+			sf::FloatRect bounds;
+			sf::IntRect rect; // Where it is in the font's texture
+			bool loaded = false;
+		};
+
+		using Glyphs = std::array<Glyph, 256>;
+
+		unsigned int getCharacterSize() const;
+		const Glyph& getGlyph(Glyphs& glyphs, unsigned int size, char c) const;
+		Glyphs& getGlyphs(unsigned int size) const;
+
 		PlatformSFML& _platform;
 		sf::Font _font;
 		bool _loaded = false;
 		double _scale;
 		double _size;
+
+		// Per character size. SFML packs the glyphs of each size into its own texture.
+		mutable std::unordered_map<unsigned int, std::unique_ptr<Glyphs>> _glyphs;
 	};
 }
 
@@ -2,16 +2,28 @@
 #define SUPER_HAXAGON_PLATFORM_SFML_HPP
 
 #include "../Platform.hpp"
+#include "../../Core/FramePacer.hpp"
+#include "../../Core/Quality.hpp"
 
 #include <SFML/Graphics.hpp>
 #include <SFML/Window/VideoMode.hpp>
 
-#include <deque>
+#include <array>
 
 namespace SuperHaxagon {
 	class Audio;
+	class InputSampler;
+	class Mixer;
+	struct Pcm;
+	class SinkSFML;
+	/**
+	 * Set SUPER_HAXAGON_FPS to cap the frame rate, and SUPER_HAXAGON_VSYNC=0
+	 * to turn vsync off. Without vsync the cap defaults to FRAME_RATE.
+	 */
 	class PlatformSFML : public Platform {
 	public:
+		static constexpr double FRAME_RATE = 60.0;
+
 		PlatformSFML(Dbg dbg, sf::VideoMode video);
 		~PlatformSFML() override;
 
@@ -23,32 +35,95 @@ namespace SuperHaxagon {
 		std::unique_ptr<Audio> loadAudio(const std::string& path, Stream stream) override;
 		std::unique_ptr<Font> loadFont(const std::string& path, int size) override;
 
-		void playSFX(Audio& audio) override;
+		void loadSFX() override;
+		void playSFX(SoundId id) override;
 		void playBGM(Audio& audio) override;
 
 		std::string getButtonName(const Buttons& button) override;
 		Buttons getPressed() override;
+		bool pollInput(std::vector<InputEvent>& events) override;
+		double getInputTime() const override;
 		Point getScreenDim() const override;
 
 		void screenBegin() override;
 		void screenSwap() override;
 		void screenFinalize() override;
+		void screenSkip() override;
 		void drawPoly(const Color& color, const std::vector<Point>& points) override;
+		bool drawStrip(const Color& color, const std::vector<Point>& points) override;
+
+		/**
+		 * Only shows anything after F3 is pressed.
+		 */
+		void getDebugInfo(std::vector<std::string>& lines) override;
 
 		std::unique_ptr<Twist> getTwister() override = 0;
 
 		void shutdown() override = 0;
 		void message(Dbg dbg, const std::string& where, const std::string& message) override = 0;
+		void vmessage(Dbg dbg, const char* where, const char* format, va_list args) override = 0;
 
 		sf::RenderWindow& getWindow() const {return *_window;}
 
+		/**
+		 * Everything drawn in a frame is collected as triangles and drawn in
+		 * screenFinalize. Returns the vertices to append to, drawn with texture.
+		 * Untextured polygons can share a run with any font texture, so text
+		 * only starts a new draw call when it switches character size.
+		 */
+		std::vector<sf::Vertex>& getBatch(const sf::Texture* texture);
+
 	private:
+		/**
+		 * Everything is drawn into a texture that is smaller than the window
+		 * by however much the quality controller asks for, and then scaled up
+		 * to fill it. (Re)creates that texture for the current window size.
+		 */
+		void applyQuality();
+
+		/**
+		 * With only vsync pacing the loop, aims the quality controller at the
+		 * display's refresh rate, measured from the last REFRESH_FRAMES frames.
+		 */
+		void measureRefresh();
+
+		/**
+		 * Buttons from the key events polled so far.
+		 */
+		Buttons getKeys() const;
+
 		bool _loaded = false;
+		bool _audible = false; // The sink started, so the mixer is running
 		bool _focus = true;
+		std::array<bool, sf::Keyboard::KeyCount> _keys{};
+		bool _overlay = false;
+		bool _applied = false;
+		bool _synced = true;
+		unsigned int _antialiasing = 0;
 		double _delta = 0.0;
+		double _idled = 0.0; // Seconds screenSkip spent waiting this frame
+		double _shortest = 1.0 / FRAME_RATE;
+		int _refreshFrames = 0;
 		sf::Clock _clock;
 		std::unique_ptr<sf::RenderWindow> _window;
-		std::deque<std::unique_ptr<Player>> _sfx;
+		std::unique_ptr<sf::RenderTexture> _texture;
+		QualityController _quality;
+		FramePacer _pacer{0};
+
+		// Stands in for vsync on loops that skip presenting
+		FramePacer _idle{FRAME_RATE};
+
+		struct Run {
+			const sf::Texture* texture;
+			size_t start;
+		};
+
+		std::vector<sf::Vertex> _batch;
+		std::vector<Run> _runs;
+		std::unique_ptr<InputSampler> _input;
+		std::unique_ptr<Mixer> _mixer;
+		std::unique_ptr<SinkSFML> _sink;
+		std::array<std::shared_ptr<const Pcm>, static_cast<size_t>(SoundId::LAST)> _sfx;
 	};
 }
 
@@ -1,16 +1,19 @@
 #ifndef SUPER_HAXAGON_PLAYER_MUSIC_SFML_HPP
 #define SUPER_HAXAGON_PLAYER_MUSIC_SFML_HPP
 
+#include "../../../include/Core/MusicClock.hpp"
 #include "../../../include/Driver/Player.hpp"
 
-#include <SFML/Audio/Music.hpp>
+#include <SFML/System/Clock.hpp>
 
 #include <memory>
 
 namespace SuperHaxagon {
+	class Mixer;
+	class MixerStream;
 	class PlayerMusicSFML : public Player {
 	public:
-		explicit PlayerMusicSFML(std::unique_ptr<sf::Music> music);
+		PlayerMusicSFML(Mixer& mixer, std::shared_ptr<MixerStream> stream);
 		~PlayerMusicSFML() override;
 
 		void setChannel(int) override {};
@@ -20,9 +23,16 @@ namespace SuperHaxagon {
 		void pause() override;
 		bool isDone() const override;
 		double getTime() const override;
+		double getLatency() const override;
 
 	private:
-		std::unique_ptr<sf::Music> _music;
+		Mixer& _mixer;
+		std::shared_ptr<MixerStream> _stream;
+		bool _loop = false;
+		bool _playing = false;
+
+		sf::Clock _now;
+		mutable MusicClock _clock;
 	};
 }
 
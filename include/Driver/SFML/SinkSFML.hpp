@@ -0,0 +1,42 @@
+#ifndef SUPER_HAXAGON_SINK_SFML_HPP
+#define SUPER_HAXAGON_SINK_SFML_HPP
+
+#include "../../../include/Core/Mixer.hpp"
+
+#include <SFML/Audio/SoundStream.hpp>
+
+namespace SuperHaxagon {
+	/**
+	 * Hands blocks rendered by the mixer to SFML. The mixer thread blocks in
+	 * write while the queue is full, which keeps it paced to the sound card.
+	 * If the stream has stopped, blocks that don't fit are dropped a block's
+	 * worth of time apart instead.
+	 */
+	class SinkSFML : public sf::SoundStream, public MixerSink {
+	public:
+		SinkSFML();
+		~SinkSFML() override;
+
+		void write(const int16_t* samples, size_t frames) override;
+		double getLatency() const override;
+
+	protected:
+		bool onGetData(Chunk& data) override;
+		void onSeek(sf::Time) override {}
+
+	private:
+		// sf::SoundStream keeps this many chunks queued up in OpenAL
+		static constexpr size_t SFML_BUFFERS = 3;
+
+		struct Block {
+			std::array<int16_t, Mixer::BLOCK_FRAMES * Mixer::CHANNELS> samples;
+			size_t frames;
+		};
+
+		Queue<Block, 8> _blocks;
+		Block _writing{};
+		Block _playing{};
+	};
+}
+
+#endif //SUPER_HAXAGON_SINK_SFML_HPP
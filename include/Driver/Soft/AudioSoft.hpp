@@ -0,0 +1,26 @@
+#ifndef SUPER_HAXAGON_AUDIO_SOFT_HPP
+#define SUPER_HAXAGON_AUDIO_SOFT_HPP
+
+#include "../../Driver/Audio.hpp"
+
+namespace SuperHaxagon {
+	class PlatformSoft;
+
+	/**
+	 * The headless driver has no audio output, but the game still needs
+	 * the BGM to keep time. Only INDIRECT audio makes a player.
+	 */
+	class AudioSoft : public Audio {
+	public:
+		AudioSoft(PlatformSoft& platform, Stream stream);
+		~AudioSoft() override;
+
+		std::unique_ptr<Player> instantiate() override;
+
+	private:
+		PlatformSoft& _platform;
+		Stream _stream;
+	};
+}
+
+#endif //SUPER_HAXAGON_AUDIO_SOFT_HPP
@@ -0,0 +1,34 @@
+#ifndef SUPER_HAXAGON_FONT_SOFT_HPP
+#define SUPER_HAXAGON_FONT_SOFT_HPP
+
+#include "../../Driver/Font.hpp"
+
+#include "../../Core/GlyphAtlas.hpp"
+
+#include <vector>
+
+namespace SuperHaxagon {
+	class PlatformSoft;
+
+	class FontSoft : public Font {
+	public:
+		/**
+		 * With blocks set the font file is never read, see GlyphAtlas.
+		 */
+		FontSoft(PlatformSoft& platform, const std::string& path, double size, bool blocks);
+		~FontSoft() override;
+
+		void setScale(double) override {};
+		double getHeight() const override;
+		double getWidth(const std::string& text) const override;
+		void draw(const Color& color, const Point& position, Alignment alignment, const std::string& text) override;
+
+	private:
+		PlatformSoft& _platform;
+
+		GlyphAtlas _atlas;
+		std::vector<GlyphAtlas::Quad> _quads;
+	};
+}
+
+#endif //SUPER_HAXAGON_FONT_SOFT_HPP
@@ -0,0 +1,102 @@
+#ifndef SUPER_HAXAGON_PLATFORM_SOFT_HPP
+#define SUPER_HAXAGON_PLATFORM_SOFT_HPP
+
+#include "../../Core/Framebuffer.hpp"
+#include "../Platform.hpp"
+#include "Rasterizer.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+namespace SuperHaxagon {
+	class Golden;
+	class Mixer;
+	class MixerSinkFile;
+	struct Pcm;
+
+	/**
+	 * Renders on the CPU into a Framebuffer, so it runs anywhere there are
+	 * threads, GPU or not. Like the headless OpenGL driver there is no input
+	 * and no audio output, and every frame is exactly one tick. Sound effects
+	 * are still mixed, one frame's worth at a time, and the music is silent.
+	 *
+	 * Set SUPER_HAXAGON_FRAMES to stop after that many frames, and
+	 * SUPER_HAXAGON_DUMP to a .ppm or .png path to write out the last one.
+	 * SUPER_HAXAGON_WIDTH and SUPER_HAXAGON_HEIGHT set the resolution, and
+	 * SUPER_HAXAGON_THREADS how many threads draw, one per core by default.
+	 * SUPER_HAXAGON_WAV writes everything mixed to a .wav file.
+	 *
+	 * Set SUPER_HAXAGON_GOLDEN to a script to replay it and check frames
+	 * against it, see Golden. The run fails if any check does, and with
+	 * SUPER_HAXAGON_GOLDEN_UPDATE set the script gets the hashes as drawn.
+	 */
+	class PlatformSoft : public Platform {
+	public:
+		static constexpr double FRAME_RATE = 60.0;
+
+		explicit PlatformSoft(Dbg dbg);
+		PlatformSoft(PlatformSoft&) = delete;
+		~PlatformSoft() override;
+
+		bool loop() override;
+		double getDilation() override;
+
+		std::string getPath(const std::string& partial) override;
+		std::string getPathRom(const std::string& partial) override;
+		std::unique_ptr<Audio> loadAudio(const std::string& path, Stream stream) override;
+		std::unique_ptr<Font> loadFont(const std::string& path, int size) override;
+
+		void loadSFX() override;
+		void playSFX(SoundId id) override;
+		void playBGM(Audio& audio) override;
+
+		std::string getButtonName(const Buttons& button) override;
+		Buttons getPressed() override;
+		Point getScreenDim() const override;
+
+		void screenBegin() override;
+		void screenSwap() override;
+		void screenFinalize() override;
+		void screenSkip() override;
+		void drawPoly(const Color& color, const std::vector<Point>& points) override;
+		bool drawStrip(const Color& color, const std::vector<Point>& points) override;
+
+		std::unique_ptr<Twist> getTwister() override;
+		bool isImmortal() override;
+
+		void shutdown() override;
+		int getExitCode() override;
+		void message(Dbg dbg, const std::string& where, const std::string& message) override;
+		void vmessage(Dbg dbg, const char* where, const char* format, va_list args) override;
+
+		uint64_t getFrames() const {return _frames;}
+		Rasterizer& getRasterizer() {return _rasterizer;}
+		const Framebuffer& getFramebuffer() const {return _framebuffer;}
+
+	private:
+		Log _log{"soft", Log::console};
+		std::unique_ptr<Golden> _golden;
+
+		uint64_t _frames = 0;
+		uint64_t _skipped = 0;
+		uint64_t _mixed = 0; // Frames that audio has been mixed for
+		uint64_t _maxFrames = 0;
+		std::string _dump;
+		std::string _sdmc = "./sdmc";
+		std::chrono::steady_clock::time_point _start;
+		std::chrono::steady_clock::duration _raster{};
+
+		Framebuffer _framebuffer;
+		Rasterizer _rasterizer;
+		std::vector<Point> _points;
+
+		std::unique_ptr<Mixer> _mixer;
+		std::unique_ptr<MixerSinkFile> _wav;
+		std::vector<int16_t> _audio;
+		std::array<std::shared_ptr<const Pcm>, static_cast<size_t>(SoundId::LAST)> _sfx;
+	};
+}
+
+#endif //SUPER_HAXAGON_PLATFORM_SOFT_HPP
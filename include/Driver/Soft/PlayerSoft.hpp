@@ -0,0 +1,39 @@
+#ifndef SUPER_HAXAGON_PLAYER_SOFT_HPP
+#define SUPER_HAXAGON_PLAYER_SOFT_HPP
+
+#include "../../Driver/Player.hpp"
+
+#include <cstdint>
+
+namespace SuperHaxagon {
+	class PlatformSoft;
+
+	/**
+	 * Silent music that plays for as many frames as the platform renders
+	 * while it is playing, so headless runs stay repeatable. Never finishes.
+	 */
+	class PlayerSoft : public Player {
+	public:
+		explicit PlayerSoft(PlatformSoft& platform);
+		~PlayerSoft() override;
+
+		void setChannel(int) override {};
+		void setLoop(bool) override {};
+
+		void play() override;
+		void pause() override;
+		bool isDone() const override {return false;}
+		double getTime() const override;
+		double getLatency() const override {return 0.0;}
+
+	private:
+		uint64_t getFrames() const;
+
+		PlatformSoft& _platform;
+		bool _playing = false;
+		uint64_t _start = 0;  // Platform frame that the music would have started on
+		uint64_t _paused = 0; // Frames played before the last pause
+	};
+}
+
+#endif //SUPER_HAXAGON_PLAYER_SOFT_HPP
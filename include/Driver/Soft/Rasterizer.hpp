@@ -0,0 +1,116 @@
+#ifndef SUPER_HAXAGON_RASTERIZER_HPP
+#define SUPER_HAXAGON_RASTERIZER_HPP
+
+#include "../../Core/Framebuffer.hpp"
+#include "../../Core/Structs.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SuperHaxagon {
+	/**
+	 * Draws triangles and glyphs into a Framebuffer on the CPU. Draws are only
+	 * recorded and sorted into screen tiles as they come in. finish then hands
+	 * tiles out to a pool of threads, and each one draws everything that
+	 * touches its tile in the order it was drawn, so blending comes out the
+	 * same as on a GPU without any locking between threads.
+	 *
+	 * Pixel centers are at half pixels and edges follow a tie breaking rule,
+	 * so triangles that share an edge never both cover a pixel on it, and
+	 * transparent fans don't show their seams. Edge functions are evaluated
+	 * four pixels at a time with SSE2 where there is one.
+	 */
+	class Rasterizer {
+	public:
+		static constexpr int TILE_SIZE = 64;
+
+		/**
+		 * threads includes the one calling finish, 0 uses one per core.
+		 */
+		explicit Rasterizer(unsigned int threads);
+		Rasterizer(Rasterizer&) = delete;
+		~Rasterizer();
+
+		unsigned int getThreads() const {return static_cast<unsigned int>(_workers.size()) + 1;}
+
+		/**
+		 * Starts a frame that fills target, which has to stay alive and the same size until finish.
+		 */
+		void begin(Framebuffer& target, const Color& clear);
+
+		/**
+		 * Points are in pixels, either winding works. Colors that aren't
+		 * fully opaque are blended over what is already there.
+		 */
+		void triangle(const Color& color, const Point& a, const Point& b, const Point& c);
+
+		/**
+		 * Draws a coverage bitmap tinted with color, one texel per pixel.
+		 * position is snapped to whole pixels. pixels has to stay alive until finish.
+		 */
+		void glyph(const Color& color, const Point& position, int width, int height, const uint8_t* pixels, int stride);
+
+		/**
+		 * Draws everything since begin, returns once the target is done.
+		 */
+		void finish();
+
+	private:
+		// Set on a bin entry if the triangle covers the whole tile, so no edges have to be tested
+		static constexpr uint32_t FULL = 0x80000000;
+
+		struct Edge {
+			double a;
+			double b;
+			double c;
+			bool inclusive; // Whether pixels exactly on the edge are inside
+		};
+
+		struct Command {
+			uint32_t color;
+			uint8_t alpha;
+			bool glyph;
+
+			// Pixels covered, x1 and y1 are exclusive
+			int x0;
+			int y0;
+			int x1;
+			int y1;
+
+			Edge edges[3];
+
+			const uint8_t* pixels;
+			int stride;
+		};
+
+		void bin(uint32_t index);
+		void work();
+		void drawTile(size_t tile);
+		void drawTriangle(const Command& command, bool full, int x0, int y0, int x1, int y1);
+		void drawGlyph(const Command& command, int x0, int y0, int x1, int y1);
+
+		Framebuffer* _target = nullptr;
+		uint32_t _clear = 0;
+		int _tilesX = 0;
+		int _tilesY = 0;
+
+		std::vector<Command> _commands;
+		std::vector<std::vector<uint32_t>> _bins;
+
+		// Threads wait for _generation to change, then take tiles until there are none left
+		std::vector<std::thread> _workers;
+		std::mutex _mutex;
+		std::condition_variable _wake;
+		std::condition_variable _done;
+		uint64_t _generation = 0;
+		unsigned int _busy = 0;
+		bool _quit = false;
+		std::atomic<size_t> _next{0};
+	};
+}
+
+#endif //SUPER_HAXAGON_RASTERIZER_HPP
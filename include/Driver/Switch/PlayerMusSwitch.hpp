@@ -1,16 +1,25 @@
 #ifndef SUPER_HAXAGON_PLAYER_MUS_SWITCH_H
 #define SUPER_HAXAGON_PLAYER_MUS_SWITCH_H
 
+#include "../../Core/MusicClock.hpp"
 #include "../../Driver/Player.hpp"
 
 #include <SDL2/SDL_mixer.h>
 
+#include <atomic>
+
 namespace SuperHaxagon {
 	class PlayerMusSwitch : public Player {
 	public:
+		static constexpr int RATE = 44100;
+		static constexpr int BUFFER_FRAMES = 4096;
+
 		explicit PlayerMusSwitch(Mix_Music* music);
 		~PlayerMusSwitch() override;
 
+		// Registered with Mix_SetPostMix, counts the frames the device consumes while music plays
+		static void postMix(void*, Uint8*, int length);
+
 		void setChannel(int) override {};
 		void setLoop(bool loop) override;
 
@@ -18,15 +27,16 @@ namespace SuperHaxagon {
 		void pause() override;
 		bool isDone() const override;
 		double getTime() const override;
+		double getLatency() const override;
 		double getNow() const;
 
 	private:
+		static std::atomic<uint64_t> _consumed;
+
 		bool _loop = false;
+		bool _playing = false;
 		Mix_Music* _music;
-
-		// Timing controls
-		double _start = 0;
-		double _diff = 0;
+		mutable MusicClock _clock;
 	};
 }
 
@@ -18,6 +18,7 @@ namespace SuperHaxagon {
 		void pause() override {};
 		bool isDone() const override {return true;}
 		double getTime() const override {return 0.0;}
+		double getLatency() const override {return 0.0;}
 
 	private:
 		Mix_Chunk* _sfx;
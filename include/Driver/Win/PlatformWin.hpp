@@ -15,8 +15,12 @@ namespace SuperHaxagon {
 
 		void shutdown() override {};
 		void message(Dbg dbg, const std::string& where, const std::string& message) override;
+		void vmessage(Dbg dbg, const char* where, const char* format, va_list args) override;
 
 		std::unique_ptr<Twist> getTwister() override;
+
+	private:
+		Log _log{"win", Log::console};
 	};
 }
 
@@ -14,6 +14,7 @@ namespace SuperHaxagon {
 	class Game;
 	class LevelFactory;
 	class PatternFactory;
+	class Stats;
 	class Twist;
 
 	class Level {
@@ -35,7 +36,7 @@ namespace SuperHaxagon {
 		Level(Level&) = delete;
 		~Level();
 
-		void update(Twist& rng, double patternDistDelete, double patternDistCreate, double dilation);
+		void update(Twist& rng, Stats& stats, double patternDistDelete, double patternDistCreate, double dilation);
 		void draw(Game& game, double scale, double offsetWall) const;
 		Movement collision(double cursorDistance, double dilation) const;
 
@@ -69,8 +70,8 @@ namespace SuperHaxagon {
 		void resetColors();
 
 	private:
-		void advanceWalls(Twist& rng, double patternDistDelete, double patternDistCreate);
-		void reverseWalls(Twist& rng, double patternDistDelete, double patternDistCreate);
+		void advanceWalls(Twist& rng, Stats& stats, double patternDistDelete, double patternDistCreate);
+		void reverseWalls(Twist& rng, Stats& stats, double patternDistDelete, double patternDistCreate);
 		const PatternFactory& getRandomPattern(Twist& rng);
 		
 		const LevelFactory* _factory;
@@ -8,11 +8,26 @@
 
 namespace SuperHaxagon {
 	class Twist;
+
+	/**
+	 * count walls in a row, starting at first, on neighbouring sides and with the
+	 * same distance and height. They move together, so they can be drawn as one
+	 * strip with no seams between them.
+	 */
+	struct WallRun {
+		size_t first;
+		int count;
+	};
+
 	class Pattern {
 	public:
+		// A run's count has to fit in WallInstance
+		static constexpr int MAX_RUN = UINT8_MAX;
+
 		Pattern(std::vector<Wall>& walls, int sides);
 
 		const std::vector<Wall>& getWalls() const {return _walls;}
+		const std::vector<WallRun>& getRuns() const {return _runs;}
 		int getSides() const {return _sides;}
 
 		double getFurthestWallDistance() const;
@@ -21,6 +36,7 @@ namespace SuperHaxagon {
 
 	private:
 		std::vector<Wall> _walls;
+		std::vector<WallRun> _runs;
 		int _sides;
 	};
 
@@ -40,6 +56,7 @@ namespace SuperHaxagon {
 		std::string getName() const {return _name;}
 
 	private:
+		// Sorted by distance, height, then side, so walls that could end up in one run are next to each other
 		std::vector<WallFactory> _walls;
 		std::string _name  = "";
 		int _sides = 0;
@@ -3,9 +3,34 @@
 
 #include "../Core/Structs.hpp"
 
+#include <cstdint>
 #include <vector>
 
 namespace SuperHaxagon {
+	/**
+	 * The least a driver needs to know to draw a run of walls, 8 bytes.
+	 * distance already has the per-frame offset taken out of it. The run
+	 * covers count sides, starting at side, as one strip.
+	 */
+	struct WallInstance {
+		float distance;
+		uint16_t height;
+		uint8_t side;
+		uint8_t count;
+	};
+
+	/**
+	 * Everything shared by all walls drawn in one batch. They still go
+	 * through the platform's transform afterwards.
+	 */
+	struct WallTransform {
+		Point focus;
+		double rotation;
+		double sides;
+		double offset;
+		double scale;
+	};
+
 	class Wall {
 	public:
 
@@ -18,6 +43,12 @@ namespace SuperHaxagon {
 		void advance(double speed);
 		Movement collision(double cursorHeight, double cursorPos, double cursorStep, int sides) const;
 		std::vector<Point> calcPoints(const Point& focus, double rotation, double sides, double offset, double scale) const;
+
+		/**
+		 * Same as calcPoints, but for count walls in a row starting with this one, as a
+		 * triangle strip going near, far, near, far... Only the two ends overflow.
+		 */
+		std::vector<Point> calcStrip(const Point& focus, double rotation, double sides, double offset, double scale, int count) const;
 		static Point calcPoint(const Point& focus, double rotation, double overflow, double distance, double sides, int side);
 
 		double getDistance() const {return _distance;}
@@ -38,6 +69,10 @@ namespace SuperHaxagon {
 
 		Wall instantiate(double offsetDistance, int offsetSide, int sides) const;
 
+		uint16_t getDistance() const {return _distance;}
+		uint16_t getHeight() const {return _height;}
+		uint16_t getSide() const {return _side;}
+
 	private:
 		uint16_t _distance = 0;
 		uint16_t _height = 0;
@@ -2,6 +2,7 @@
 #define SUPER_HAXAGON_MENU_HPP
 
 #include "State.hpp"
+#include "../Core/Hud.hpp"
 
 #include "../Core/Structs.hpp"
 
@@ -27,6 +28,7 @@ namespace SuperHaxagon {
 		void drawBot(double scale) override;
 		void enter() override;
 		void exit() override {};
+		Redraw getRedraw() const override;
 
 	private:
 		Game& _game;
@@ -40,6 +42,16 @@ namespace SuperHaxagon {
 		std::map<LocColor, Color> _color;
 		std::map<LocColor, Color> _colorNext;
 		std::map<LocColor, size_t> _colorNextIndex;
+
+		// Only rebuilt when a different level is selected
+		const LevelFactory* _hudLevel = nullptr;
+		HudText _textName;
+		HudText _textDiff;
+		HudText _textMode;
+		HudText _textAuth;
+		HudText _textBest;
+		HudPanel _panelInfo{HudPanel::Anchor::TOP_LEFT};
+		HudPanel _panelTime{HudPanel::Anchor::BOTTOM_LEFT};
 	};
 }
 
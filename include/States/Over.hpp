@@ -2,6 +2,7 @@
 #define SUPER_HAXAGON_OVER_HPP
 
 #include "State.hpp"
+#include "../Core/Hud.hpp"
 
 #include "../Core/Structs.hpp"
 
@@ -26,6 +27,7 @@ namespace SuperHaxagon {
 		void drawTop(double scale) override;
 		void drawBot(double scale) override;
 		void enter() override;
+		Redraw getRedraw() const override;
 
 	private:
 		Game& _game;
@@ -33,6 +35,10 @@ namespace SuperHaxagon {
 		LevelFactory& _selected;
 		std::unique_ptr<Level> _level;
 		std::string _text = "GAME OVER";
+		HudText _textScore;
+		HudText _textBest;
+		HudText _textPlay;
+		HudText _textQuit;
 
 		bool _high = false;
 		double _score = 0;
@@ -2,6 +2,10 @@
 #define SUPER_HAXAGON_PLAY_HPP
 
 #include "State.hpp"
+#include "../Core/Hud.hpp"
+#include "../Driver/Platform.hpp"
+
+#include <vector>
 
 namespace SuperHaxagon {
 	class Game;
@@ -28,17 +32,39 @@ namespace SuperHaxagon {
 		void exit() override;
 
 	private:
+		/**
+		 * Buttons pressed at any point since the last update, and how much
+		 * of that time the cursor was being moved left and right, from 0 to 1.
+		 */
+		struct Held {
+			Buttons pressed;
+			double left;
+			double right;
+		};
+
+		Held readInput();
+
 		Game& _game;
 		Platform& _platform;
 		LevelFactory& _factory;
 		LevelFactory& _selected;
 		std::unique_ptr<Level> _level;
 
+		HudText _levelUpText;
+		HudText _scoreText;
+		HudPanel _levelUpPanel{HudPanel::Anchor::TOP_LEFT};
+		HudPanel _scorePanel{HudPanel::Anchor::TOP_RIGHT};
+
 		double _scalePrev = 0;
 		double _scoreWidth = 0;
 		double _score = 0;
 		double _skewFrame = 0.0;
 		double _skewDirection = 1.0;
+
+		// Where the input events left off last update
+		std::vector<InputEvent> _events;
+		Buttons _buttons{};
+		double _inputTime = 0.0;
 	};
 }
 
@@ -4,8 +4,21 @@
 #include <memory>
 
 namespace SuperHaxagon {
+	/**
+	 * How often a state has to be drawn. Input is polled and update is called
+	 * every loop no matter what, this only decides if the screen is redrawn.
+	 */
+	enum class Redraw {
+		STATIC, // Nothing moves, redrawn every FRAMES_PER_STATIC
+		LOW, // Only slow animations, redrawn every FRAMES_PER_LOW
+		FULL, // Redrawn every loop
+	};
+
 	class State {
 	public:
+		static constexpr double FRAMES_PER_LOW = 4;
+		static constexpr double FRAMES_PER_STATIC = 60;
+
 		virtual ~State() = default;
 
 		virtual std::unique_ptr<State> update(double dilation) = 0;
@@ -13,6 +26,11 @@ namespace SuperHaxagon {
 		virtual void drawBot(double scale) = 0;
 		virtual void enter() {};
 		virtual void exit() {};
+
+		/**
+		 * Asked after every update. The frame after a state changes is always drawn.
+		 */
+		virtual Redraw getRedraw() const {return Redraw::FULL;}
 	};
 }
 
@@ -2,6 +2,7 @@
 #define SUPER_HAXAGON_TRANSITION_HPP
 
 #include "State.hpp"
+#include "../Core/Hud.hpp"
 
 #include "../Core/Structs.hpp"
 
@@ -30,6 +31,8 @@ namespace SuperHaxagon {
 		Platform& _platform;
 		LevelFactory& _selected;
 		std::unique_ptr<Level> _level;
+		HudText _text;
+		HudPanel _panel{HudPanel::Anchor::TOP_CENTER};
 
 		double _score = 0;
 		double _frames = 0;
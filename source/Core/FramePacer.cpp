@@ -0,0 +1,55 @@
+#include "../../include/Core/FramePacer.hpp"
+
+#include "../../include/Core/Trace.hpp"
+
+#include <algorithm>
+#include <thread>
+
+namespace SuperHaxagon {
+	FramePacer::FramePacer(const double rate) {
+		setRate(rate);
+	}
+
+	void FramePacer::setRate(const double rate) {
+		_rate = rate > 0 ? rate : 0;
+		_period = _rate > 0 ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / _rate)) : Clock::duration{};
+		_started = false;
+	}
+
+	void FramePacer::wait() {
+		if (_rate <= 0) return;
+
+		TRACE_ZONE("FramePacer::wait");
+
+		auto now = Clock::now();
+		if (!_started) {
+			// Nothing to hold the first frame to
+			_started = true;
+			_deadline = now + _period;
+			return;
+		}
+
+		// Sleep most of the way, the scheduler usually wakes up late
+		const auto margin = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(_slop + SPIN));
+		const auto wake = _deadline - margin;
+		if (now < wake) {
+			std::this_thread::sleep_until(wake);
+			now = Clock::now();
+			const auto overshoot = std::chrono::duration<double>(now - wake).count();
+			_slop = std::max({overshoot, _slop * SLOP_DECAY, SLOP_MIN});
+		}
+
+		// Then spin for the rest
+		while (now < _deadline) {
+			std::this_thread::yield();
+			now = Clock::now();
+		}
+
+		_late = std::chrono::duration<double>(now - _deadline).count();
+		if (_late > LATE) _missed++;
+
+		// Don't try to catch up after falling a whole frame behind, that would only rush the next few
+		_deadline += _period;
+		if (now >= _deadline) _deadline = now + _period;
+	}
+}
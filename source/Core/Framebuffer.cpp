@@ -0,0 +1,137 @@
+#include "../../include/Core/Framebuffer.hpp"
+
+#include <array>
+#include <cstdio>
+
+namespace SuperHaxagon {
+	// Biggest block deflate can store without compressing it
+	static constexpr size_t DEFLATE_BLOCK = 65535;
+
+	static uint32_t crc(uint32_t crc, const uint8_t* data, const size_t size) {
+		static const auto table = [] {
+			std::array<uint32_t, 256> table{};
+			for (uint32_t i = 0; i < table.size(); i++) {
+				auto c = i;
+				for (auto bit = 0; bit < 8; bit++) c = c & 1 ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+				table[i] = c;
+			}
+
+			return table;
+		}();
+
+		crc = ~crc;
+		for (size_t i = 0; i < size; i++) crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+		return ~crc;
+	}
+
+	static void putBig(std::vector<uint8_t>& out, const uint32_t value) {
+		out.push_back(static_cast<uint8_t>(value >> 24));
+		out.push_back(static_cast<uint8_t>(value >> 16));
+		out.push_back(static_cast<uint8_t>(value >> 8));
+		out.push_back(static_cast<uint8_t>(value));
+	}
+
+	static bool putChunk(std::FILE* file, const char* type, const std::vector<uint8_t>& data) {
+		std::vector<uint8_t> chunk;
+		chunk.reserve(data.size() + 12);
+		putBig(chunk, static_cast<uint32_t>(data.size()));
+		chunk.insert(chunk.end(), type, type + 4);
+		chunk.insert(chunk.end(), data.begin(), data.end());
+		putBig(chunk, crc(0, chunk.data() + 4, chunk.size() - 4));
+		return std::fwrite(chunk.data(), 1, chunk.size(), file) == chunk.size();
+	}
+
+	Framebuffer::Framebuffer(const int width, const int height) {
+		resize(width, height);
+	}
+
+	Framebuffer::~Framebuffer() = default;
+
+	void Framebuffer::resize(const int width, const int height) {
+		_width = width > 0 ? width : 0;
+		_height = height > 0 ? height : 0;
+		_pixels.assign(static_cast<size_t>(_width) * _height, pack(COLOR_BLACK));
+	}
+
+	bool Framebuffer::write(const std::string& path) const {
+		const auto png = path.size() >= 4 && path.compare(path.size() - 4, 4, ".png") == 0;
+		return png ? writePNG(path) : writePPM(path);
+	}
+
+	bool Framebuffer::writePPM(const std::string& path) const {
+		auto* file = std::fopen(path.c_str(), "wb");
+		if (!file) return false;
+
+		auto ok = std::fprintf(file, "P6\n%d %d\n255\n", _width, _height) > 0;
+		std::vector<uint8_t> row(static_cast<size_t>(_width) * 3);
+		for (auto y = 0; ok && y < _height; y++) {
+			const auto* pixels = getRow(y);
+			for (auto x = 0; x < _width; x++) {
+				const auto color = unpack(pixels[x]);
+				row[x * 3] = color.r;
+				row[x * 3 + 1] = color.g;
+				row[x * 3 + 2] = color.b;
+			}
+
+			ok = std::fwrite(row.data(), 1, row.size(), file) == row.size();
+		}
+
+		return std::fclose(file) == 0 && ok;
+	}
+
+	bool Framebuffer::writePNG(const std::string& path) const {
+		// Every row is a filter byte (none) and then RGB
+		const auto stride = static_cast<size_t>(_width) * 3 + 1;
+		std::vector<uint8_t> raw(stride * _height);
+		for (auto y = 0; y < _height; y++) {
+			auto* out = &raw[stride * y];
+			*out++ = 0;
+			const auto* pixels = getRow(y);
+			for (auto x = 0; x < _width; x++) {
+				const auto color = unpack(pixels[x]);
+				*out++ = color.r;
+				*out++ = color.g;
+				*out++ = color.b;
+			}
+		}
+
+		// A zlib stream made of stored deflate blocks, then the adler32 of everything in them
+		std::vector<uint8_t> data{0x78, 0x01};
+		data.reserve(raw.size() + raw.size() / DEFLATE_BLOCK * 5 + 16);
+		uint32_t a = 1;
+		uint32_t b = 0;
+		size_t at = 0;
+		do {
+			const auto size = raw.size() - at < DEFLATE_BLOCK ? raw.size() - at : DEFLATE_BLOCK;
+			data.push_back(at + size == raw.size() ? 1 : 0);
+			data.push_back(static_cast<uint8_t>(size));
+			data.push_back(static_cast<uint8_t>(size >> 8));
+			data.push_back(static_cast<uint8_t>(~size));
+			data.push_back(static_cast<uint8_t>(~size >> 8));
+			for (size_t i = at; i < at + size; i++) {
+				a = (a + raw[i]) % 65521;
+				b = (b + a) % 65521;
+			}
+
+			data.insert(data.end(), raw.begin() + at, raw.begin() + at + size);
+			at += size;
+		} while (at < raw.size());
+
+		putBig(data, b << 16 | a);
+
+		std::vector<uint8_t> header;
+		putBig(header, _width);
+		putBig(header, _height);
+		header.insert(header.end(), {8, 2, 0, 0, 0}); // 8 bit RGB, no interlacing
+
+		auto* file = std::fopen(path.c_str(), "wb");
+		if (!file) return false;
+
+		static constexpr uint8_t signature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+		auto ok = std::fwrite(signature, 1, sizeof(signature), file) == sizeof(signature);
+		ok = ok && putChunk(file, "IHDR", header);
+		ok = ok && putChunk(file, "IDAT", data);
+		ok = ok && putChunk(file, "IEND", {});
+		return std::fclose(file) == 0 && ok;
+	}
+}
@@ -1,30 +1,68 @@
 #include "../../include/Core/Game.hpp"
 
 #include "../../include/Core/Metadata.hpp"
+#include "../../include/Core/Trace.hpp"
 #include "../../include/Core/Twist.hpp"
 #include "../../include/Driver/Font.hpp"
 #include "../../include/Driver/Platform.hpp"
 #include "../../include/Factories/Level.hpp"
 #include "../../include/Factories/Pattern.hpp"
+#include "../../include/Factories/Wall.hpp"
 #include "../../include/States/Load.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 namespace SuperHaxagon {
+	/**
+	 * Keeps the part of a convex polygon where a * x + b * y + c >= 0.
+	 */
+	static void clipEdge(const std::vector<Point>& in, std::vector<Point>& out, const double a, const double b, const double c) {
+		out.clear();
+		for (size_t i = 0; i < in.size(); i++) {
+			const auto& p = in[i];
+			const auto& q = in[(i + 1) % in.size()];
+			const auto dp = a * p.x + b * p.y + c;
+			const auto dq = a * q.x + b * q.y + c;
+			if (dp >= 0) out.push_back(p);
+			if ((dp >= 0) != (dq >= 0)) {
+				const auto t = dp / (dp - dq);
+				out.push_back({p.x + (q.x - p.x) * t, p.y + (q.y - p.y) * t});
+			}
+		}
+	}
+
+	/**
+	 * Which way a convex polygon winds, 1 or -1.
+	 */
+	static double winding(const std::vector<Point>& polygon) {
+		const auto& a = polygon[0];
+		const auto& b = polygon[1];
+		const auto& c = polygon[2];
+		return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x) > 0 ? 1.0 : -1.0;
+	}
+
+	/**
+	 * The half-plane on the inside of the edge from p to q, for clipEdge.
+	 */
+	static void insideOf(const Point& p, const Point& q, const double sign, double& a, double& b, double& c) {
+		a = -sign * (q.y - p.y);
+		b = sign * (q.x - p.x);
+		c = -(a * p.x + b * p.y);
+	}
 
 	Game::Game(Platform& platform) : _platform(platform) {
 		// Audio loading
-		_sfxBegin = platform.loadAudio(platform.getPathRom("/sound/begin"), Stream::DIRECT);
-		_sfxHexagon = platform.loadAudio(platform.getPathRom("/sound/hexagon"), Stream::DIRECT);
-		_sfxOver = platform.loadAudio(platform.getPathRom("/sound/over"), Stream::DIRECT);
-		_sfxSelect = platform.loadAudio(platform.getPathRom("/sound/select"), Stream::DIRECT);
-		_sfxLevelUp = platform.loadAudio(platform.getPathRom("/sound/level"), Stream::DIRECT);
-		_sfxWonderful = platform.loadAudio(platform.getPathRom("/sound/wonderful"), Stream::DIRECT);
+		platform.loadSFX();
+		const auto* sounds = platform.getSounds();
+		if (sounds) platform.message(Dbg::INFO, "sound", "sfx use " + std::to_string(sounds->getMemoryUsage()) + " bytes");
 
 		_small = platform.loadFont(platform.getPathRom("/bump-it-up"), 16);
 		_large = platform.loadFont(platform.getPathRom("/bump-it-up"), 32);
 
 		_twister = platform.getTwister();
+		_shadowWallTransform = std::make_unique<WallTransform>();
 	}
 
 	Game::~Game() {
@@ -35,7 +73,13 @@ namespace SuperHaxagon {
 	void Game::run() {
 		_state = std::make_unique<Load>(*this);
 		_state->enter();
+
+		// Loops since the last frame that was drawn, and the screen it was drawn to
+		auto idle = std::numeric_limits<double>::infinity();
+		Point drawn{};
 		while(_running && _platform.loop()) {
+			TRACE_ZONE("Game::run");
+
 			// The original game was built with a 3DS in mind, so when
 			// drawing we have to scale the game to however many times larger the viewport is.
 			const auto scale = getScreenDimMin() / 240.0;
@@ -43,18 +87,45 @@ namespace SuperHaxagon {
 
 			auto next = _state->update(dilation);
 			if (!_running) break;
+			if (next) idle = std::numeric_limits<double>::infinity();
 			while (next) {
+				TRACE_ZONE("Game::run transition");
+				_platform.getStats().add(Stat::STATE_TRANSITIONS);
 				_state->exit();
 				_state = std::move(next);
 				_state->enter();
 				next = _state->update(dilation);
 			}
 
-			_platform.screenBegin();
-			_state->drawTop(scale);
-			_platform.screenSwap();
-			_state->drawBot(scale);
+			// Idle states don't need every frame, the overlay and a resize always do
+			_debug.clear();
+			_platform.getDebugInfo(_debug);
+			if (!_debug.empty()) _platform.getStats().getLines(_debug);
+			const auto dim = _platform.getScreenDim();
+			const auto redraw = _state->getRedraw();
+			idle += dilation;
+			if (redraw == Redraw::FULL || !_debug.empty() || dim.x != drawn.x || dim.y != drawn.y) idle = std::numeric_limits<double>::infinity();
+			if (idle < (redraw == Redraw::LOW ? State::FRAMES_PER_LOW : State::FRAMES_PER_STATIC)) {
+				TRACE_ZONE("Game::run skip");
+				_platform.screenSkip();
+				endFrame();
+				continue;
+			}
+
+			idle = 0;
+			drawn = dim;
+			{
+				TRACE_ZONE("Game::run draw");
+				_platform.screenBegin();
+				_state->drawTop(scale);
+				_platform.screenSwap();
+				_state->drawBot(scale);
+				drawDebug(scale);
+			}
+
+			TRACE_ZONE("Game::run finalize");
 			_platform.screenFinalize();
+			endFrame();
 		}
 	}
 
@@ -77,6 +148,13 @@ namespace SuperHaxagon {
 		// The game used to be based off a 3DS which has a bottom screen of 240px
 		const auto maxRenderDistance = SCALE_BASE_DISTANCE * (getScreenDimMax() / 240);
 		const auto exactSides = static_cast<size_t>(std::ceil(sides));
+		const auto madeUp = interpolateColor(color1, color2, 0.5f);
+
+		const BackgroundTransform transform{focus, multiplier * maxRenderDistance, rotation, sides};
+		_platform.pushTransform(getSkewTransform());
+		const auto drawn = _platform.drawBackground(color1, color2, madeUp, transform);
+		_platform.popTransform();
+		if (drawn) return;
 
 		//solid background.
 		const Point position = {0,0};
@@ -88,30 +166,28 @@ namespace SuperHaxagon {
 		edges.resize(exactSides);
 
 		for(size_t i = 0; i < exactSides; i++) {
-			edges[i].x = multiplier * maxRenderDistance * cos(rotation + i * TAU / sides) + focus.x;
-			edges[i].y = multiplier * maxRenderDistance * sin(rotation + i * TAU / sides + PI) + focus.y;
+			edges[i].x = transform.distance * cos(rotation + i * TAU / sides) + focus.x;
+			edges[i].y = transform.distance * sin(rotation + i * TAU / sides + PI) + focus.y;
 		}
 
+		// The triangles reach way past the screen, so most of them get clipped
 		std::vector<Point> triangle;
-		triangle.resize(3);
+		_platform.pushTransform(getSkewTransform());
+		updateView();
 
 		//if the sides is odd we need to "make up a color" to put in the gap between the last and first color
 		if(exactSides % 2) {
-			triangle[0] = focus;
-			triangle[1] = edges[exactSides - 1];
-			triangle[2] = edges[0];
-			skew(triangle);
-			_platform.drawPoly(interpolateColor(color1, color2, 0.5f), triangle);
+			triangle = {focus, edges[exactSides - 1], edges[0]};
+			if (clip(triangle)) _platform.drawPoly(madeUp, triangle);
 		}
 
 		//Draw the rest of the triangles
-		for(size_t i = 0; i < exactSides - 1; i = i + 2) {
-			triangle[0] = focus;
-			triangle[1] = edges[i];
-			triangle[2] = edges[i + 1];
-			skew(triangle);
-			_platform.drawPoly(color2, triangle);
+		for(size_t i = 0; i + 1 < exactSides; i = i + 2) {
+			triangle = {focus, edges[i], edges[i + 1]};
+			if (clip(triangle)) _platform.drawPoly(color2, triangle);
 		}
+
+		_platform.popTransform();
 	}
 
 	void Game::drawRegular(const Color& color, const Point& focus, const double height, const double rotation, const double sides) const {
@@ -126,8 +202,9 @@ namespace SuperHaxagon {
 			edges[i].y = height * sin(rotation + i * TAU/sides + PI) + focus.y;
 		}
 
-		skew(edges);
-		_platform.drawPoly(color, edges);
+		_platform.pushTransform(getSkewTransform());
+		drawShape(color, edges);
+		_platform.popTransform();
 	}
 
 	void Game::drawCursor(const Color& color, const Point& focus, const double cursor, const double rotation, const double offset, const double scale) const {
@@ -143,26 +220,238 @@ namespace SuperHaxagon {
 			p.y = orig.y + focus.y;
 		}
 
-		skew(triangle);
-		_platform.drawPoly(color, triangle);
+		_platform.pushTransform(getSkewTransform());
+		drawShape(color, triangle);
+		_platform.popTransform();
 	}
 
 	void Game::drawPatterns(const Color& color, const Point& focus, const std::deque<Pattern>& patterns, const double rotation, const double sides, const double offset, const double scale) const {
+		_platform.pushTransform(getSkewTransform());
+		updateView();
+		updateReach(focus, rotation, sides);
+
+		_walls.clear();
 		for(const auto& pattern : patterns) {
-			for(const auto& wall : pattern.getWalls()) {
-				drawWalls(color, focus, wall, rotation, sides, offset, scale);
+			const auto& walls = pattern.getWalls();
+			for(auto run : pattern.getRuns()) {
+				if (!isVisible(walls, run, sides, offset, scale)) continue;
+				const auto& wall = walls[run.first];
+				_walls.push_back({
+					static_cast<float>(wall.getDistance()),
+					static_cast<uint16_t>(wall.getHeight()),
+					static_cast<uint8_t>(wall.getSide()),
+					static_cast<uint8_t>(run.count)
+				});
+			}
+		}
+
+		const WallTransform transform{focus, rotation, sides, offset, scale};
+		if (!_walls.empty() && _platform.drawWalls(color, transform, _walls)) {
+			if (_shadowing) {
+				_shadowWalls = _walls;
+				*_shadowWallTransform = transform;
+			}
+		} else if (!_walls.empty()) {
+			for(const auto& pattern : patterns) {
+				const auto& walls = pattern.getWalls();
+				for(auto run : pattern.getRuns()) {
+					if (isVisible(walls, run, sides, offset, scale)) drawWalls(color, focus, walls[run.first], run.count, rotation, sides, offset, scale);
+				}
 			}
 		}
+
+		_platform.popTransform();
 	}
 
-	void Game::drawWalls(const Color& color, const Point& focus, const Wall& wall, const double rotation, const double sides, const double offset, const double scale) const {
+	void Game::drawWalls(const Color& color, const Point& focus, const Wall& wall, int count, const double rotation, const double sides, const double offset, const double scale) const {
 		const auto distance = wall.getDistance() + offset;
 		if(distance + wall.getHeight() < SCALE_HEX_LENGTH) return; //TOO_CLOSE;
-		if(wall.getSide() >= sides) return; //NOT_IN_RANGE
-		auto trap = wall.calcPoints(focus, rotation, sides, offset, scale);
+		count = std::min(count, static_cast<int>(std::ceil(sides)) - wall.getSide());
+		if(count <= 0) return; //NOT_IN_RANGE
+
+		if(count == 1) {
+			auto trap = wall.calcPoints(focus, rotation, sides, offset, scale);
+			if (clip(trap)) drawShape(color, trap);
+			return;
+		}
 
-		skew(trap);
-		_platform.drawPoly(color, trap);
+		// A strip bends around the hexagon so it isn't convex, leave it to the driver to clip
+		const auto strip = wall.calcStrip(focus, rotation, sides, offset, scale, count);
+		drawShapeStrip(color, strip);
+	}
+
+	void Game::drawShape(const Color& color, const std::vector<Point>& points) const {
+		_platform.drawPoly(color, points);
+		if (!_shadowing) return;
+		_shapes.push_back({false, _shapePoints.size(), points.size()});
+		_shapePoints.insert(_shapePoints.end(), points.begin(), points.end());
+	}
+
+	bool Game::drawShapeStrip(const Color& color, const std::vector<Point>& points) const {
+		if (_shadowing) {
+			_shapes.push_back({true, _shapePoints.size(), points.size()});
+			_shapePoints.insert(_shapePoints.end(), points.begin(), points.end());
+		}
+
+		if (_platform.drawStrip(color, points)) return true;
+
+		std::vector<Point> triangle;
+		for(size_t i = 2; i < points.size(); i++) {
+			triangle = {points[i - 2], points[i - 1], points[i]};
+			_platform.drawPoly(color, triangle);
+		}
+
+		return false;
+	}
+
+	void Game::beginShadow(const Point& offset) const {
+		_shadowing = true;
+		_shadowX = offset.x;
+		_shadowY = offset.y;
+		_shapes.clear();
+		_shapePoints.clear();
+		_shadowWalls.clear();
+		_platform.pushTransform(translate(offset));
+	}
+
+	void Game::endShadow() const {
+		_platform.popTransform();
+		_shadowing = false;
+		_shadowX = 0.0;
+		_shadowY = 0.0;
+	}
+
+	void Game::drawShadowed(const Color& color) const {
+		_platform.pushTransform(getSkewTransform());
+		if (!_shadowWalls.empty()) _platform.drawWalls(color, *_shadowWallTransform, _shadowWalls);
+
+		for (const auto& shape : _shapes) {
+			const auto first = _shapePoints.begin() + static_cast<std::ptrdiff_t>(shape.start);
+			_shape.assign(first, first + static_cast<std::ptrdiff_t>(shape.count));
+			if (shape.strip) drawShapeStrip(color, _shape);
+			else drawShape(color, _shape);
+		}
+
+		_platform.popTransform();
+	}
+
+	void Game::updateView() const {
+		const auto screen = _platform.getScreenDim();
+		Transform inverse{};
+
+		// Squished flat, nothing can be seen
+		_view.clear();
+		if (!invert(_platform.getTransform(), inverse)) return;
+
+		// A shadow is kept to be drawn again without its offset, so it has to
+		// take in whatever is on screen either way
+		const auto left = std::min(0.0, _shadowX);
+		const auto top = std::min(0.0, _shadowY);
+		const auto right = screen.x + std::max(0.0, _shadowX);
+		const auto bottom = screen.y + std::max(0.0, _shadowY);
+		_view.push_back(transformPoint(inverse, {left, top}));
+		_view.push_back(transformPoint(inverse, {right, top}));
+		_view.push_back(transformPoint(inverse, {right, bottom}));
+		_view.push_back(transformPoint(inverse, {left, bottom}));
+	}
+
+	bool Game::clip(std::vector<Point>& points) const {
+		if (_view.size() < 3) return false;
+
+		auto inside = true;
+		const auto sign = winding(_view);
+		for (size_t i = 0; i < _view.size(); i++) {
+			double a, b, c;
+			insideOf(_view[i], _view[(i + 1) % _view.size()], sign, a, b, c);
+			for (const auto& point : points) inside = inside && a * point.x + b * point.y + c >= 0;
+		}
+
+		if (inside) return points.size() >= 3;
+
+		// An even amount of edges, so the result ends up back in points
+		for (size_t i = 0; i < _view.size(); i++) {
+			double a, b, c;
+			insideOf(_view[i], _view[(i + 1) % _view.size()], sign, a, b, c);
+			if (i % 2) clipEdge(_clipped, points, a, b, c);
+			else clipEdge(points, _clipped, a, b, c);
+		}
+
+		return points.size() >= 3;
+	}
+
+	void Game::updateReach(const Point& focus, const double rotation, const double sides) const {
+		const auto exactSides = static_cast<size_t>(std::ceil(sides));
+		_reach.assign(exactSides, std::numeric_limits<double>::infinity());
+
+		// Past half a turn a side isn't convex anymore, so just draw everything
+		const auto width = TAU / sides;
+		if (width + Wall::WALL_OVERFLOW * 2 >= PI) return;
+
+		// The screen before it was transformed, relative to focus
+		std::vector<Point> visible;
+		for (const auto& point : _view) visible.push_back({point.x - focus.x, point.y - focus.y});
+
+		for (size_t i = 0; i < exactSides; i++) {
+			// The same angles Wall::calcPoint uses, where a direction is (cos, -sin)
+			const auto start = rotation + i * width - Wall::WALL_OVERFLOW;
+			const auto end = rotation + std::min((i + 1) * width + Wall::WALL_OVERFLOW, TAU + Wall::WALL_OVERFLOW);
+			const Point from{cos(start), -sin(start)};
+			const Point to{cos(end), -sin(end)};
+
+			// Keep what is between the two edges of the side, whichever way they wind
+			const auto sign = from.x * to.y - from.y * to.x > 0 ? 1.0 : -1.0;
+			clipEdge(visible, _wedge, -sign * from.y, sign * from.x, 0);
+			clipEdge(_wedge, _clipped, sign * to.y, -sign * to.x, 0);
+
+			// The furthest point of a convex polygon is one of its corners
+			auto reach = 0.0;
+			for (const auto& point : _clipped) reach = std::max(reach, std::sqrt(point.x * point.x + point.y * point.y));
+			_reach[i] = reach;
+		}
+	}
+
+	bool Game::isVisible(const std::vector<Wall>& walls, WallRun& run, const double sides, const double offset, const double scale) const {
+		const auto& wall = walls[run.first];
+		const auto distance = wall.getDistance() + offset;
+		if(distance + wall.getHeight() < SCALE_HEX_LENGTH) return false; //TOO_CLOSE;
+		run.count = std::min(run.count, static_cast<int>(std::ceil(sides)) - wall.getSide()); //NOT_IN_RANGE
+
+		// Drop walls off either end that start further out than anything on screen in their direction
+		const auto start = std::max(distance, SCALE_HEX_LENGTH) * scale;
+		const auto seen = [&](const int i) {
+			const auto side = static_cast<size_t>(walls[run.first].getSide() + i);
+			return side >= _reach.size() || start <= _reach[side];
+		};
+
+		while(run.count > 0 && !seen(0)) {
+			run.first++;
+			run.count--;
+		}
+
+		while(run.count > 0 && !seen(run.count - 1)) run.count--;
+		return run.count > 0;
+	}
+
+	void Game::endFrame() {
+		auto& stats = _platform.getStats();
+		if (stats.endFrame()) _platform.message(Dbg::INFO, "stats", stats.getReport());
+	}
+
+	void Game::drawDebug(const double scale) {
+		if (_debug.empty()) return;
+
+		auto& font = getFontSmall();
+		font.setScale(scale);
+
+		const auto pad = SCALE_HUMAN_PADDING * scale;
+		const auto height = font.getHeight();
+		auto width = 0.0;
+		for (const auto& line : _debug) width = std::max(width, font.getWidth(line));
+
+		drawRect(COLOR_TRANSPARENT, {0, 0}, {width + pad * 2, height * _debug.size() + pad * 2});
+		for (size_t i = 0; i < _debug.size(); i++) {
+			font.draw(COLOR_WHITE, {pad, pad + height * i}, Alignment::LEFT, _debug[i]);
+		}
 	}
 
 	Point Game::getScreenCenter() const {
@@ -171,19 +460,19 @@ namespace SuperHaxagon {
 	}
 
 	Point Game::getShadowOffset() const {
+		// Shadows move after the skew, so they get squished the same way
 		const auto min = getScreenDimMin();
+		const auto squish = 1.0 - _skew;
 		if (_shadowAuto) {
-			return {0, min/180 + min/15 * _skew};
+			return {0, (min/180 + min/15 * _skew) * squish};
 		}
 
-		return {min/60, min/60};
+		return {min/60, min/60 * squish};
 	}
 
-	void Game::skew(std::vector<Point>& skew) const {
+	Transform Game::getSkewTransform() const {
 		const auto screen = _platform.getScreenDim();
-		for (auto& point : skew) {
-			point.y = ((point.y / screen.y - 0.5) * (1.0 - _skew) + 0.5) * screen.y;
-		}
+		return {1, 0, 0, 0, 1.0 - _skew, _skew * screen.y / 2};
 	}
 
 	Font& Game::getFontSmall() const {
@@ -205,6 +494,7 @@ namespace SuperHaxagon {
 	}
 
 	void Game::loadBGMAudio(const LevelFactory& factory) {
+		TRACE_ZONE("Game::loadBGMAudio");
 		const auto base = "/bgm" + factory.getMusic();
 		std::string path;
 		std::string pathMeta;
@@ -0,0 +1,217 @@
+#include "../../include/Core/GlyphAtlas.hpp"
+
+#define STB_TRUETYPE_IMPLEMENTATION
+#include <stb_truetype.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+
+namespace SuperHaxagon {
+	// Textures larger than this are not guaranteed to be supported by every GPU
+	static constexpr int MAX_TEXTURE_SIZE = 4096;
+
+	// Block glyphs are this much of the em, in the proportions of a typical capital
+	static constexpr double BLOCK_WIDTH = 0.5;
+	static constexpr double BLOCK_HEIGHT = 0.75;
+	static constexpr double BLOCK_ADVANCE = 0.625;
+
+	GlyphAtlas::GlyphAtlas(const std::string& path, const double size) {
+		std::ifstream file(path, std::ios::binary);
+		if (!file) return;
+
+		const std::vector<unsigned char> data{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+		if (data.empty()) return;
+
+		stbtt_fontinfo info;
+		if (!stbtt_InitFont(&info, data.data(), stbtt_GetFontOffsetForIndex(data.data(), 0))) return;
+
+		// Scale by the em square rather than the line height so sizes
+		// match what FreeType (and everything else) calls a pixel size.
+		const auto scale = stbtt_ScaleForMappingEmToPixels(&info, static_cast<float>(size));
+
+		std::vector<Box> boxes;
+		for (auto c = GLYPH_START; c < GLYPH_END; c++) {
+			int advance, bearing;
+			stbtt_GetCodepointHMetrics(&info, c, &advance, &bearing);
+			_glyphs[c].advance = advance * scale;
+
+			Box box{c, 0, 0, 0, 0};
+			stbtt_GetCodepointBitmapBox(&info, c, scale, scale, &box.x0, &box.y0, &box.x1, &box.y1);
+			if (box.x1 <= box.x0 || box.y1 <= box.y0) continue;
+
+			_ascent = std::max(_ascent, static_cast<double>(-box.y0));
+			boxes.push_back(box);
+		}
+
+		_loaded = build(boxes, [&info, scale, this](const Box& box, uint8_t* out) {
+			stbtt_MakeCodepointBitmap(&info, out, box.x1 - box.x0, box.y1 - box.y0, _texWidth, scale, scale, box.c);
+		});
+	}
+
+	GlyphAtlas::GlyphAtlas(const double size) {
+		const auto width = static_cast<int>(std::lround(size * BLOCK_WIDTH));
+		const auto height = static_cast<int>(std::lround(size * BLOCK_HEIGHT));
+		if (width <= 0 || height <= 0) return;
+
+		// Whole pixels, so that the pen never lands between two
+		_ascent = height;
+		std::vector<Box> boxes;
+		for (auto c = GLYPH_START; c < GLYPH_END; c++) {
+			_glyphs[c].advance = std::round(size * BLOCK_ADVANCE);
+			if (c != ' ' && c != GLYPH_END - 1) boxes.push_back({c, 0, -height, width, 0});
+		}
+
+		_loaded = build(boxes, [this](const Box& box, uint8_t* out) {
+			for (auto y = 0; y < box.y1 - box.y0; y++) std::fill_n(out + static_cast<size_t>(y) * _texWidth, box.x1 - box.x0, 0xFF);
+		});
+	}
+
+	template <typename Draw>
+	bool GlyphAtlas::build(std::vector<Box>& boxes, Draw draw) {
+		auto area = 0;
+		for (const auto& box : boxes) area += (box.x1 - box.x0 + PADDING) * (box.y1 - box.y0 + PADDING);
+
+		// Tallest first keeps the skyline flat, which wastes a lot less space
+		std::sort(boxes.begin(), boxes.end(), [](const Box& a, const Box& b) {
+			const auto ha = a.y1 - a.y0;
+			const auto hb = b.y1 - b.y0;
+			return ha != hb ? ha > hb : a.x1 - a.x0 > b.x1 - b.x0;
+		});
+
+		// Start with the smallest square that could possibly fit
+		// everything and keep doubling the height until it does.
+		_texWidth = 64;
+		while (_texWidth * _texWidth < area && _texWidth < MAX_TEXTURE_SIZE) _texWidth *= 2;
+		_texHeight = _texWidth / 2;
+
+		std::vector<Point> placed(boxes.size());
+		auto packed = false;
+		while (!packed && _texHeight < MAX_TEXTURE_SIZE) {
+			_texHeight *= 2;
+			_skyline = {{0, 0, _texWidth}};
+			packed = true;
+			for (size_t i = 0; i < boxes.size() && packed; i++) {
+				int x, y;
+				packed = pack(boxes[i].x1 - boxes[i].x0 + PADDING, boxes[i].y1 - boxes[i].y0 + PADDING, x, y);
+				placed[i] = {static_cast<double>(x), static_cast<double>(y)};
+			}
+		}
+
+		_skyline.clear();
+		_skyline.shrink_to_fit();
+		if (!packed) return false;
+
+		_pixels.assign(static_cast<size_t>(_texWidth) * _texHeight, 0);
+		for (size_t i = 0; i < boxes.size(); i++) {
+			const auto& box = boxes[i];
+			const auto x = static_cast<int>(placed[i].x);
+			const auto y = static_cast<int>(placed[i].y);
+			const auto w = box.x1 - box.x0;
+			const auto h = box.y1 - box.y0;
+
+			draw(box, &_pixels[static_cast<size_t>(y) * _texWidth + x]);
+
+			auto& glyph = _glyphs[box.c];
+			glyph.offset = {static_cast<double>(box.x0), static_cast<double>(box.y0)};
+			glyph.size = {static_cast<double>(w), static_cast<double>(h)};
+			glyph.uv0 = {static_cast<double>(x) / _texWidth, static_cast<double>(y) / _texHeight};
+			glyph.uv1 = {static_cast<double>(x + w) / _texWidth, static_cast<double>(y + h) / _texHeight};
+		}
+
+		return true;
+	}
+
+	GlyphAtlas::~GlyphAtlas() = default;
+
+	double GlyphAtlas::getWidth(const std::string& text) const {
+		auto width = 0.0;
+		for (const auto c : text) width += getGlyph(c).advance;
+		return width;
+	}
+
+	const GlyphAtlas::Glyph& GlyphAtlas::getGlyph(const char c) const {
+		// Anything outside of ASCII has no glyph, and the ones below GLYPH_START are empty
+		const auto i = static_cast<unsigned char>(c);
+		return i < GLYPH_END ? _glyphs[i] : _glyphs[0];
+	}
+
+	void GlyphAtlas::layout(const std::string& text, const Point& position, std::vector<Quad>& quads) const {
+		if (!_loaded) return;
+
+		auto pen = position.x;
+		const auto baseline = position.y + _ascent;
+		for (const auto c : text) {
+			const auto& glyph = getGlyph(c);
+			if (glyph.size.x > 0 && glyph.size.y > 0) {
+				quads.push_back({
+					{std::round(pen + glyph.offset.x), std::round(baseline + glyph.offset.y)},
+					glyph.size,
+					glyph.uv0,
+					glyph.uv1
+				});
+			}
+
+			pen += glyph.advance;
+		}
+	}
+
+	bool GlyphAtlas::pack(const int width, const int height, int& x, int& y) {
+		// Bottom left skyline: try the rectangle at the left edge of every
+		// node and keep the position where its top ends up the highest.
+		auto best = _skyline.size();
+		auto bestY = _texHeight;
+		auto bestX = _texWidth;
+		for (size_t i = 0; i < _skyline.size(); i++) {
+			const auto left = _skyline[i].x;
+			if (left + width > _texWidth) break;
+
+			// Resting height is the tallest node the rectangle spans
+			auto top = 0;
+			auto remaining = width;
+			for (auto j = i; remaining > 0; j++) {
+				top = std::max(top, _skyline[j].y);
+				remaining -= _skyline[j].width;
+			}
+
+			if (top + height > _texHeight) continue;
+			if (top < bestY || (top == bestY && left < bestX)) {
+				best = i;
+				bestY = top;
+				bestX = left;
+			}
+		}
+
+		if (best == _skyline.size()) return false;
+
+		x = bestX;
+		y = bestY;
+		_skyline.insert(_skyline.begin() + best, {x, y + height, width});
+
+		// Cut away whatever the new node now shadows
+		for (auto i = best + 1; i < _skyline.size();) {
+			const auto end = _skyline[i - 1].x + _skyline[i - 1].width;
+			if (_skyline[i].x >= end) break;
+
+			const auto shrink = end - _skyline[i].x;
+			_skyline[i].x += shrink;
+			_skyline[i].width -= shrink;
+			if (_skyline[i].width > 0) break;
+
+			_skyline.erase(_skyline.begin() + i);
+		}
+
+		// Neighbours at the same height act as one node
+		for (size_t i = 0; i + 1 < _skyline.size();) {
+			if (_skyline[i].y == _skyline[i + 1].y) {
+				_skyline[i].width += _skyline[i + 1].width;
+				_skyline.erase(_skyline.begin() + i + 1);
+			} else {
+				i++;
+			}
+		}
+
+		return true;
+	}
+}
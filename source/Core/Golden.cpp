@@ -0,0 +1,291 @@
+#include "../../include/Core/Golden.hpp"
+
+#include "../../include/Core/Framebuffer.hpp"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+namespace SuperHaxagon {
+	static const char* BUDGET_NAMES[] = {"polygons", "calls", "text", "allocations", "time"};
+
+	static_assert(sizeof(BUDGET_NAMES) / sizeof(BUDGET_NAMES[0]) == static_cast<size_t>(Budget::LAST), "every budget needs a name");
+
+	static constexpr double NO_LIMIT = std::numeric_limits<double>::infinity();
+
+	// Iterations in one calibration loop, a couple of milliseconds on a desktop
+	static constexpr uint32_t CALIBRATION_STEPS = 1 << 20;
+	static constexpr int CALIBRATION_RUNS = 5;
+
+	// Keeps the calibration loop from being optimized away
+	static volatile double calibrationSink = 0.0;
+
+	/**
+	 * Times a fixed amount of integer and float work, the best of a few runs
+	 * so that a context switch doesn't make every budget looser.
+	 */
+	static double calibrate() {
+		auto best = std::numeric_limits<double>::infinity();
+		for (auto run = 0; run < CALIBRATION_RUNS; run++) {
+			const auto start = std::chrono::steady_clock::now();
+			uint32_t state = 0x9E3779B9;
+			auto sum = 0.0;
+			for (uint32_t i = 0; i < CALIBRATION_STEPS; i++) {
+				state ^= state << 13;
+				state ^= state >> 17;
+				state ^= state << 5;
+				sum += state * 1e-9;
+			}
+
+			calibrationSink = sum;
+			best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+		}
+
+		return best;
+	}
+
+	static constexpr uint64_t FNV_BASIS = 0xCBF29CE484222325;
+
+	/**
+	 * One step of FNV-1a for every byte of word, lowest first.
+	 */
+	static void mixHash(uint64_t& hash, const uint32_t word, const int bytes) {
+		for (auto shift = 0; shift < bytes * 8; shift += 8) {
+			hash ^= (word >> shift) & 0xFF;
+			hash *= 0x100000001B3;
+		}
+	}
+
+	static std::string formatHash(const uint64_t hash) {
+		char text[17];
+		std::snprintf(text, sizeof(text), "%016" PRIx64, hash);
+		return text;
+	}
+
+	/**
+	 * FNV-1a over the size and every pixel.
+	 */
+	static std::string hashFrame(const Framebuffer& framebuffer) {
+		auto hash = FNV_BASIS;
+		mixHash(hash, static_cast<uint32_t>(framebuffer.getWidth()), 4);
+		mixHash(hash, static_cast<uint32_t>(framebuffer.getHeight()), 4);
+		for (auto y = 0; y < framebuffer.getHeight(); y++) {
+			const auto* row = framebuffer.getRow(y);
+			for (auto x = 0; x < framebuffer.getWidth(); x++) mixHash(hash, row[x], 4);
+		}
+
+		return formatHash(hash);
+	}
+
+	static bool parseButton(const std::string& name, Buttons& buttons) {
+		if (name == "select") buttons.select = true;
+		else if (name == "back") buttons.back = true;
+		else if (name == "quit") buttons.quit = true;
+		else if (name == "left") buttons.left = true;
+		else if (name == "right") buttons.right = true;
+		else return false;
+		return true;
+	}
+
+	Golden::Golden(Platform& platform, const std::string& path, const bool update) : _platform(platform), _path(path), _update(update), _audioHash(FNV_BASIS) {
+		std::ifstream file(path);
+		if (!file) {
+			platform.message(Dbg::WARN, "golden", "cannot open " + path);
+			return;
+		}
+
+		std::string line;
+		_loaded = true;
+		while (std::getline(file, line)) {
+			_lines.emplace_back(line);
+			if (!parse(line, _lines.size())) _loaded = false;
+		}
+
+		if (!_loaded) return;
+
+		_calibration = calibrate();
+		_last = std::chrono::steady_clock::now();
+		platform.message(Dbg::INFO, "golden", std::to_string(_checks.size()) + " checks over " + std::to_string(_frames) + " frames, calibrated at " + std::to_string(_calibration * 1000.0) + " ms");
+	}
+
+	Golden::~Golden() = default;
+
+	bool Golden::parse(const std::string& line, const size_t number) {
+		std::istringstream in(line.substr(0, line.find('#')));
+		std::string command;
+		if (!(in >> command)) return true;
+
+		const auto fail = [this, number](const std::string& why) {
+			_platform.message(Dbg::WARN, "golden", "line " + std::to_string(number) + ": " + why);
+			return false;
+		};
+
+		if (command == "press" || command == "hold" || command == "immortal") {
+			Input input{0, 0, Buttons{}, command == "immortal"};
+			if (!(in >> input.first)) return fail("expected a frame");
+			input.last = input.first;
+			if (command != "press" && !(in >> input.last)) return fail("expected a last frame");
+			if (input.last < input.first) return fail("range ends before it starts");
+
+			std::string button;
+			while (in >> button) {
+				if (input.immortal || !parseButton(button, input.buttons)) return fail("unexpected " + button);
+			}
+
+			_inputs.emplace_back(input);
+			_frames = std::max(_frames, input.last + 1);
+			return true;
+		}
+
+		if (command == "check") {
+			Check check{0, "", "", {}, _lines.size() - 1, false};
+			check.limits.fill(NO_LIMIT);
+			if (!(in >> check.frame >> check.name >> check.hash)) return fail("expected a frame, a name and a hash");
+
+			std::string budget;
+			while (in >> budget) {
+				const auto equals = budget.find('=');
+				const auto name = budget.substr(0, equals);
+				const auto* found = std::find(std::begin(BUDGET_NAMES), std::end(BUDGET_NAMES), name);
+				if (equals == std::string::npos || found == std::end(BUDGET_NAMES)) return fail("unknown budget " + budget);
+				check.limits[found - std::begin(BUDGET_NAMES)] = std::strtod(budget.c_str() + equals + 1, nullptr);
+			}
+
+			_checks.emplace_back(check);
+			_frames = std::max(_frames, check.frame + 1);
+			return true;
+		}
+
+		if (command == "audio") {
+			if (!_audio.empty()) return fail("audio is already checked");
+			if (!(in >> _audio)) return fail("expected a hash");
+			_audioLine = _lines.size() - 1;
+			return true;
+		}
+
+		return fail("unknown command " + command);
+	}
+
+	Buttons Golden::getPressed(const uint64_t frame) const {
+		Buttons buttons{};
+		for (const auto& input : _inputs) {
+			if (frame < input.first || frame > input.last) continue;
+			buttons.select = buttons.select || input.buttons.select;
+			buttons.back = buttons.back || input.buttons.back;
+			buttons.quit = buttons.quit || input.buttons.quit;
+			buttons.left = buttons.left || input.buttons.left;
+			buttons.right = buttons.right || input.buttons.right;
+		}
+
+		return buttons;
+	}
+
+	bool Golden::isImmortal(const uint64_t frame) const {
+		return std::any_of(_inputs.begin(), _inputs.end(), [frame](const Input& input) {
+			return input.immortal && frame >= input.first && frame <= input.last;
+		});
+	}
+
+	void Golden::endFrame(const uint64_t frames, const Framebuffer& framebuffer, const Stats& stats, const uint64_t allocations) {
+		if (!_loaded || frames <= _finished) return;
+
+		const auto now = std::chrono::steady_clock::now();
+		const auto& last = stats.getLast();
+		std::array<double, BUDGETS> used{};
+		used[static_cast<size_t>(Budget::POLYGONS)] = static_cast<double>(last[static_cast<size_t>(Stat::POLYGONS)]);
+		used[static_cast<size_t>(Budget::DRAW_CALLS)] = static_cast<double>(last[static_cast<size_t>(Stat::DRAW_CALLS)]);
+		used[static_cast<size_t>(Budget::TEXT_DRAWS)] = static_cast<double>(last[static_cast<size_t>(Stat::TEXT_DRAWS)]);
+		used[static_cast<size_t>(Budget::ALLOCATIONS)] = static_cast<double>(allocations - _allocations);
+		used[static_cast<size_t>(Budget::TIME)] = std::chrono::duration<double>(now - _last).count() / _calibration;
+
+		const auto frame = frames - 1;
+		for (auto& check : _checks) {
+			if (check.frame == frame) compare(check, framebuffer, used);
+		}
+
+		_finished = frames;
+		_allocations = allocations;
+
+		// Checking takes a while, don't count it against the next frame
+		_last = std::chrono::steady_clock::now();
+	}
+
+	void Golden::addAudio(const int16_t* samples, const size_t frames) {
+		for (size_t i = 0; i < frames * 2; i++) mixHash(_audioHash, static_cast<uint16_t>(samples[i]), 2);
+	}
+
+	void Golden::compare(Check& check, const Framebuffer& framebuffer, const std::array<double, BUDGETS>& used) {
+		check.reached = true;
+		auto passed = true;
+		const auto hash = hashFrame(framebuffer);
+		if (_update) {
+			check.hash = hash;
+		} else if (check.hash == "-") {
+			_unrecorded++;
+		} else if (check.hash != hash) {
+			const auto path = _platform.getPath("/golden-" + check.name + ".png");
+			framebuffer.write(path);
+			_platform.message(Dbg::WARN, "golden", check.name + " drew " + hash + " instead of " + check.hash + ", see " + path);
+			passed = false;
+		}
+
+		for (size_t i = 0; i < BUDGETS; i++) {
+			if (used[i] <= check.limits[i]) continue;
+			_platform.message(Dbg::WARN, "golden", check.name + " is over its " + BUDGET_NAMES[i] + " budget, " + std::to_string(used[i]) + " of " + std::to_string(check.limits[i]));
+			passed = false;
+		}
+
+		if (!passed) _failed++;
+	}
+
+	bool Golden::finish() {
+		if (!_loaded) return false;
+
+		for (const auto& check : _checks) {
+			if (check.reached) continue;
+			_platform.message(Dbg::WARN, "golden", check.name + " was never drawn, frame " + std::to_string(check.frame) + " is past the end of the run");
+			_failed++;
+		}
+
+		// Counts as one more check, so it has its own line in the totals
+		const auto audio = formatHash(_audioHash);
+		auto checks = _checks.size();
+		if (!_audio.empty()) {
+			checks++;
+			if (_update) {
+				_audio = audio;
+			} else if (_audio == "-") {
+				_unrecorded++;
+			} else if (_audio != audio) {
+				_platform.message(Dbg::WARN, "golden", "audio mixed " + audio + " instead of " + _audio + ", write it out with SUPER_HAXAGON_WAV to listen");
+				_failed++;
+			}
+		}
+
+		if (_update) {
+			// Only the hash changes, everything after it is kept as it was
+			for (const auto& check : _checks) {
+				auto& line = _lines[check.line];
+				std::istringstream in(line);
+				std::string command, frame, name, hash;
+				in >> command >> frame >> name >> hash;
+				const auto rest = in.eof() ? std::string() : line.substr(static_cast<size_t>(in.tellg()));
+				line = command + " " + frame + " " + name + " " + check.hash + rest;
+			}
+
+			if (!_audio.empty()) _lines[_audioLine] = "audio " + _audio;
+
+			std::ofstream out(_path);
+			for (const auto& line : _lines) out << line << '\n';
+			if (out.good()) _platform.message(Dbg::INFO, "golden", "wrote hashes to " + _path);
+			else _platform.message(Dbg::WARN, "golden", "could not write " + _path);
+		}
+
+		if (_unrecorded) _platform.message(Dbg::WARN, "golden", std::to_string(_unrecorded) + " checks have no hash yet, only their budgets were checked");
+		_platform.message(_failed ? Dbg::WARN : Dbg::INFO, "golden", std::to_string(checks - std::min(_failed, checks)) + " of " + std::to_string(checks) + " checks passed");
+		return _failed == 0;
+	}
+}
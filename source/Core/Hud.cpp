@@ -0,0 +1,69 @@
+#include "../../include/Core/Hud.hpp"
+
+#include "../../include/Driver/Font.hpp"
+#include "../../include/Driver/Platform.hpp"
+
+#include <cstring>
+
+namespace SuperHaxagon {
+	void HudText::set(const char* text) {
+		if (_text == text) return;
+		_text = text;
+		_dirty = true;
+	}
+
+	void HudText::setTime(const char* prefix, const double score) {
+		char buffer[64];
+		const auto length = std::strlen(prefix);
+		if (length >= sizeof(buffer)) return;
+		std::memcpy(buffer, prefix, length);
+		formatTime(buffer + length, sizeof(buffer) - length, score);
+		set(buffer);
+	}
+
+	double HudText::getWidth(const Font& font, const double scale) {
+		if (_dirty || &font != _font || scale != _scale) {
+			_width = font.getWidth(_text);
+			_font = &font;
+			_scale = scale;
+			_dirty = false;
+		}
+
+		return _width;
+	}
+
+	void HudText::draw(Font& font, const Color& color, const Point& position, const Alignment alignment) const {
+		font.draw(color, position, alignment, _text);
+	}
+
+	void HudPanel::update(const Point& size, const Point& screen) {
+		if (size.x == _size.x && size.y == _size.y && screen.x == _screen.x && screen.y == _screen.y) return;
+		_size = size;
+		_screen = screen;
+
+		// Clockwise, from top left
+		const auto w = size.x;
+		const auto h = size.y;
+		switch (_anchor) {
+			case Anchor::TOP_LEFT:
+				_points = {{0, 0}, {w + h / 2, 0}, {w, h}, {0, h}};
+				break;
+			case Anchor::TOP_RIGHT:
+				_points = {{screen.x - w - h / 2, 0}, {screen.x, 0}, {screen.x, h}, {screen.x - w, h}};
+				break;
+			case Anchor::TOP_CENTER: {
+				const auto center = screen.x / 2;
+				_points = {{center - w / 2 - h / 2, 0}, {center + w / 2 + h / 2, 0}, {center + w / 2, h}, {center - w / 2, h}};
+				break;
+			}
+			case Anchor::BOTTOM_LEFT:
+				_points = {{0, screen.y - h}, {w, screen.y - h}, {w + h / 2, screen.y}, {0, screen.y}};
+				break;
+		}
+	}
+
+	void HudPanel::draw(Platform& platform, const Color& color) const {
+		if (_points.empty()) return;
+		platform.drawPoly(color, _points);
+	}
+}
@@ -0,0 +1,24 @@
+#include "../../include/Core/InputSampler.hpp"
+
+namespace SuperHaxagon {
+	static bool same(const Buttons& a, const Buttons& b) {
+		return a.select == b.select && a.back == b.back && a.quit == b.quit && a.left == b.left && a.right == b.right;
+	}
+
+	InputSampler::InputSampler() : _epoch(std::chrono::steady_clock::now()) {}
+
+	void InputSampler::poll(std::vector<InputEvent>& events) {
+		events.clear();
+		InputEvent event{};
+		while (_events.pop(event)) events.push_back(event);
+	}
+
+	void InputSampler::record(const Buttons& buttons) {
+		// A full queue just drops the change, the next one that fits brings it up to date
+		if (!same(buttons, _recorded) && _events.push({getTime(), buttons})) _recorded = buttons;
+	}
+
+	double InputSampler::getTime() const {
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - _epoch).count();
+	}
+}
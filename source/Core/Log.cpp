@@ -0,0 +1,186 @@
+#include "../../include/Core/Log.hpp"
+
+#include "../../include/Core/Trace.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+namespace SuperHaxagon {
+	static const char* LEVEL_NAMES[] = {"info", "warn", "fatal"};
+
+	static_assert(sizeof(LEVEL_NAMES) / sizeof(LEVEL_NAMES[0]) == static_cast<size_t>(Dbg::FATAL) + 1, "every level needs a name");
+
+	// How long the flusher sleeps when there's nothing to write
+	static constexpr auto LOG_INTERVAL = std::chrono::milliseconds(10);
+
+	bool LogLimit::allow(uint32_t& suppressed) {
+		const auto second = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		auto last = _second.load(std::memory_order_relaxed);
+		if (last != second && _second.compare_exchange_strong(last, second, std::memory_order_relaxed)) {
+			_sent.store(0, std::memory_order_relaxed);
+			suppressed = _suppressed.exchange(0, std::memory_order_relaxed);
+		}
+
+		if (_sent.fetch_add(1, std::memory_order_relaxed) < LOG_BURST) return true;
+		_suppressed.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	void Log::console(const Dbg dbg, const std::string& line, const bool last) {
+		if (dbg == Dbg::FATAL) {
+			std::cerr << line << std::endl;
+			return;
+		}
+
+		std::cout << line << '\n';
+		if (last) std::cout.flush();
+	}
+
+	Log::Log(const char* prefix, Sink sink) : _prefix(prefix), _sink(std::move(sink)), _slots(new Slot[LOG_SLOTS]) {
+		for (size_t i = 0; i < LOG_SLOTS; i++) _slots[i].sequence.store(i, std::memory_order_relaxed);
+		_line.reserve(LOG_WHERE + LOG_TEXT + 32);
+		_held.reserve(LOG_WHERE + LOG_TEXT + 32);
+		_flusher = std::thread(&Log::run, this);
+	}
+
+	Log::~Log() {
+		stop();
+	}
+
+	void Log::push(const Dbg dbg, const std::string& where, const std::string& message) {
+		if (!logEnabled(dbg)) return;
+
+		size_t position;
+		auto* slot = claim(position);
+		if (!slot) return;
+
+		slot->dbg = dbg;
+		slot->whereLength = static_cast<uint8_t>(std::min(where.size(), LOG_WHERE));
+		slot->textLength = static_cast<uint8_t>(std::min(message.size(), LOG_TEXT));
+		slot->truncated = message.size() > LOG_TEXT;
+		std::memcpy(slot->where, where.data(), slot->whereLength);
+		std::memcpy(slot->text, message.data(), slot->textLength);
+		publish(slot, position);
+	}
+
+	void Log::vpush(const Dbg dbg, const char* where, const char* format, va_list args) {
+		if (!logEnabled(dbg)) return;
+
+		size_t position;
+		auto* slot = claim(position);
+		if (!slot) return;
+
+		const auto written = std::vsnprintf(slot->text, sizeof(slot->text), format, args);
+		const auto length = static_cast<size_t>(std::max(written, 0));
+		slot->dbg = dbg;
+		slot->whereLength = static_cast<uint8_t>(strnlen(where, LOG_WHERE));
+		slot->textLength = static_cast<uint8_t>(std::min(length, LOG_TEXT));
+		slot->truncated = length > LOG_TEXT;
+		std::memcpy(slot->where, where, slot->whereLength);
+		publish(slot, position);
+	}
+
+	Log::Slot* Log::claim(size_t& position) {
+		// A slot's sequence matches the position once the consumer is done with it
+		position = _head.load(std::memory_order_relaxed);
+		while (true) {
+			auto* slot = &_slots[position % LOG_SLOTS];
+			const auto sequence = slot->sequence.load(std::memory_order_acquire);
+			const auto ahead = static_cast<std::ptrdiff_t>(sequence - position);
+			if (ahead == 0) {
+				if (_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) return slot;
+			} else if (ahead < 0) {
+				_dropped.fetch_add(1, std::memory_order_relaxed);
+				return nullptr;
+			} else {
+				position = _head.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	void Log::publish(Slot* slot, const size_t position) {
+		const auto dbg = slot->dbg;
+		slot->sequence.store(position + 1, std::memory_order_release);
+
+		if (dbg == Dbg::FATAL || !_running.load(std::memory_order_acquire)) {
+			flush();
+		} else if ((position + 1) % (LOG_SLOTS / 2) == 0) {
+			// Half full, don't wait out the interval
+			_wakeup.notify_one();
+		}
+	}
+
+	void Log::flush() {
+		TRACE_ZONE("Log::flush");
+		std::lock_guard<std::mutex> guard(_drain);
+
+		// Lines are held back by one so that the sink knows which is last
+		auto pending = false;
+		auto pendingDbg = Dbg::INFO;
+		const auto decorate = [this](const Dbg dbg) {
+			_line = "[";
+			_line += _prefix;
+			_line += ":";
+			_line += LEVEL_NAMES[static_cast<size_t>(dbg)];
+			_line += "] ";
+		};
+
+		const auto write = [&](const Dbg dbg) {
+			if (pending) _sink(pendingDbg, _held, false);
+			_held.swap(_line);
+			pendingDbg = dbg;
+			pending = true;
+		};
+
+		const auto dropped = _dropped.exchange(0, std::memory_order_relaxed);
+		if (dropped) {
+			decorate(Dbg::WARN);
+			_line += "log: " + std::to_string(dropped) + " messages dropped";
+			write(Dbg::WARN);
+		}
+
+		while (true) {
+			auto& slot = _slots[_tail % LOG_SLOTS];
+			if (slot.sequence.load(std::memory_order_acquire) != _tail + 1) break;
+
+			decorate(slot.dbg);
+			_line.append(slot.where, slot.whereLength);
+			_line += ": ";
+			_line.append(slot.text, slot.textLength);
+			if (slot.truncated) _line += "...";
+			const auto dbg = slot.dbg;
+
+			// Hand the slot back to the producers
+			slot.sequence.store(_tail + LOG_SLOTS, std::memory_order_release);
+			_tail++;
+			write(dbg);
+		}
+
+		if (pending) _sink(pendingDbg, _held, true);
+	}
+
+	void Log::stop() {
+		{
+			std::lock_guard<std::mutex> guard(_wake);
+			if (!_running.exchange(false, std::memory_order_acq_rel)) return;
+		}
+
+		_wakeup.notify_one();
+		if (_flusher.joinable()) _flusher.join();
+		flush();
+	}
+
+	void Log::run() {
+		TRACE_THREAD("log");
+		std::unique_lock<std::mutex> lock(_wake);
+		while (_running.load(std::memory_order_acquire)) {
+			lock.unlock();
+			flush();
+			lock.lock();
+			_wakeup.wait_for(lock, LOG_INTERVAL);
+		}
+	}
+}
@@ -1,4 +1,5 @@
 #include "../../include/Core/Game.hpp"
+#include "../../include/Core/Trace.hpp"
 #include "../../include/Driver/Platform.hpp" 
 
 #if defined _3DS
@@ -7,6 +8,12 @@
 #include "Driver/Switch/PlatformSwitch.hpp"
 #elif defined _WIN64 || defined __CYGWIN__
 #include "../../include/Driver/Win/PlatformWin.hpp"
+#elif defined DESKTOP_SDL
+#include "Driver/SDL/PlatformSDL.hpp"
+#elif defined LINUX_SOFT
+#include "Driver/Soft/PlatformSoft.hpp"
+#elif defined LINUX_GL
+#include "Driver/LinuxGL/PlatformLinuxGL.hpp"
 #elif defined __linux__
 #include "Driver/Linux/PlatformLinux.hpp"
 #else
@@ -21,6 +28,12 @@ namespace SuperHaxagon {
 		return std::make_unique<PlatformSwitch>(Dbg::INFO);
 		#elif defined _WIN64 || defined __CYGWIN__
 		return std::make_unique<PlatformWin>(Dbg::INFO);
+		#elif defined DESKTOP_SDL
+		return std::make_unique<PlatformSDL>(Dbg::INFO);
+		#elif defined LINUX_SOFT
+		return std::make_unique<PlatformSoft>(Dbg::INFO);
+		#elif defined LINUX_GL
+		return std::make_unique<PlatformLinuxGL>(Dbg::INFO);
 		#elif defined __linux__
 		return std::make_unique<PlatformLinux>(Dbg::INFO);
 		#else
@@ -43,7 +56,14 @@ int main(int, char**) {
 	}
 
 	platform->message(SuperHaxagon::Dbg::INFO, "main", "stopping main");
+
+	#ifdef SUPER_HAXAGON_TRACE
+	const auto trace = platform->getPath("/trace.json");
+	if (SuperHaxagon::writeTrace(trace)) platform->message(SuperHaxagon::Dbg::INFO, "main", "wrote " + trace);
+	else platform->message(SuperHaxagon::Dbg::WARN, "main", "could not write " + trace);
+	#endif
+
 	platform->shutdown();
 
-	return 0;
+	return platform->getExitCode();
 }
\ No newline at end of file
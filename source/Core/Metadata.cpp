@@ -1,13 +1,22 @@
 #include "../../include/Core/Metadata.hpp"
 
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 
 namespace SuperHaxagon {
+	static const char* LABEL_NAMES[] = {
+		"S", "I", "BL", "BS", "HYPER", "PSURROUND", "C",
+		"L0", "L1", "L2", "L3", "L4", "L5", "L6"
+	};
+
+	static_assert(sizeof(LABEL_NAMES) / sizeof(LABEL_NAMES[0]) == static_cast<size_t>(Label::LAST), "every label needs a name");
+	static_assert(static_cast<size_t>(Label::LAST) <= 32, "labels must fit in the event mask");
+
 	Metadata::Metadata(const std::string& path) {
 		std::ifstream metadata(path);
 		if (!metadata) return;
-		
+
 		std::string line;
 		while (std::getline(metadata, line)) {
 			std::stringstream values(line);
@@ -21,27 +30,36 @@ namespace SuperHaxagon {
 			values.ignore(256, '\t');
 			values >> label;
 
-			_timestamps[label].push_back(time);
+			const auto* name = std::find(std::begin(LABEL_NAMES), std::end(LABEL_NAMES), label);
+			if (name == std::end(LABEL_NAMES)) continue; // nothing reacts to it
+
+			_events.push_back({time, static_cast<Label>(name - std::begin(LABEL_NAMES))});
 		}
+
+		// Audacity usually sorts labels, but files edited by hand might not be
+		std::stable_sort(_events.begin(), _events.end(), [](const Event& a, const Event& b) {
+			return a.time < b.time;
+		});
 	}
 
 	Metadata::~Metadata() = default;
 
-	bool Metadata::getMetadata(const double time, const std::string& label) {
-		if (_timestamps.find(label) == _timestamps.end()) return false; // no data
+	uint32_t Metadata::advance(const double time) {
+		// If more than 10 seconds behind, seek to the first event that has not happened yet
+		if (time < _time - 10) {
+			_cursor = std::lower_bound(_events.begin(), _events.end(), time, [](const Event& event, const double t) {
+				return event.time < t;
+			}) - _events.begin();
+		}
 
-		// If more than 10 seconds behind, reset
-		if (time < _time - 10) _indices.clear();
 		_time = time;
 
-		auto event = false;
-		// While not at end and the current timestamp is less than the requested one
-		// Note: C++ crates _indices[label] when it is accessed for the first time
-		while (_indices[label] != _timestamps[label].size() && _timestamps[label][_indices[label]] < time) {
-			_indices[label]++;
-			event = true;
+		uint32_t fired = 0;
+		while (_cursor != _events.size() && _events[_cursor].time < time) {
+			fired |= mask(_events[_cursor].label);
+			_cursor++;
 		}
-		
-		return event;
+
+		return fired;
 	}
 }
@@ -0,0 +1,326 @@
+#include "../../include/Core/Mixer.hpp"
+
+#include "../../include/Core/Trace.hpp"
+
+#include <algorithm>
+
+namespace SuperHaxagon {
+	static constexpr uint32_t FIXED_ONE = 1u << 16;
+
+	static int16_t clamp16(const int32_t sample) {
+		if (sample < INT16_MIN) return INT16_MIN;
+		if (sample > INT16_MAX) return INT16_MAX;
+		return static_cast<int16_t>(sample);
+	}
+
+	MixerSinkFile::MixerSinkFile(const std::string& path) : _file(path, std::ios::out | std::ios::binary) {
+		if (!_file) return;
+
+		// Sizes are filled in once the file is closed
+		const uint32_t zero = 0;
+		const uint32_t formatSize = 16;
+		const uint16_t format = 1; // PCM
+		const uint16_t channels = Mixer::CHANNELS;
+		const uint32_t rate = Mixer::RATE;
+		const uint32_t byteRate = Mixer::RATE * Mixer::CHANNELS * sizeof(int16_t);
+		const uint16_t align = Mixer::CHANNELS * sizeof(int16_t);
+		const uint16_t bits = 16;
+
+		_file.write("RIFF", 4);
+		_file.write(reinterpret_cast<const char*>(&zero), sizeof(zero));
+		_file.write("WAVEfmt ", 8);
+		_file.write(reinterpret_cast<const char*>(&formatSize), sizeof(formatSize));
+		_file.write(reinterpret_cast<const char*>(&format), sizeof(format));
+		_file.write(reinterpret_cast<const char*>(&channels), sizeof(channels));
+		_file.write(reinterpret_cast<const char*>(&rate), sizeof(rate));
+		_file.write(reinterpret_cast<const char*>(&byteRate), sizeof(byteRate));
+		_file.write(reinterpret_cast<const char*>(&align), sizeof(align));
+		_file.write(reinterpret_cast<const char*>(&bits), sizeof(bits));
+		_file.write("data", 4);
+		_file.write(reinterpret_cast<const char*>(&zero), sizeof(zero));
+	}
+
+	MixerSinkFile::~MixerSinkFile() {
+		if (!_file) return;
+		const uint32_t riff = _bytes + 36;
+		_file.seekp(4);
+		_file.write(reinterpret_cast<const char*>(&riff), sizeof(riff));
+		_file.seekp(40);
+		_file.write(reinterpret_cast<const char*>(&_bytes), sizeof(_bytes));
+	}
+
+	void MixerSinkFile::write(const int16_t* samples, const size_t frames) {
+		if (!_file) return;
+		const auto bytes = static_cast<uint32_t>(frames * Mixer::CHANNELS * sizeof(int16_t));
+		_file.write(reinterpret_cast<const char*>(samples), bytes);
+		_bytes += bytes;
+	}
+
+	Mixer::Mixer() :
+		_decoded(BLOCK_FRAMES * MAX_STREAM_RATIO * CHANNELS),
+		_accumulator(BLOCK_FRAMES * CHANNELS) {}
+
+	Mixer::~Mixer() {
+		stop();
+	}
+
+	bool Mixer::playSFX(std::shared_ptr<const Pcm> pcm, const int polyphony) {
+		if (!pcm || !pcm->samples || pcm->channels < 1 || pcm->channels > CHANNELS || !pcm->rate) return true;
+		Command command;
+		command.op = Op::PLAY;
+		command.polyphony = polyphony;
+		command.pcm = std::move(pcm);
+		return push(std::move(command));
+	}
+
+	bool Mixer::playStream(std::shared_ptr<MixerStream> stream, const bool loop) {
+		Command command;
+		command.op = Op::PLAY;
+		command.loop = loop;
+		command.stream = std::move(stream);
+		return push(std::move(command));
+	}
+
+	bool Mixer::pauseStream(std::shared_ptr<MixerStream> stream) {
+		Command command;
+		command.op = Op::PAUSE;
+		command.stream = std::move(stream);
+		return push(std::move(command));
+	}
+
+	bool Mixer::stopStream(std::shared_ptr<MixerStream> stream) {
+		Command command;
+		command.op = Op::STOP;
+		command.stream = std::move(stream);
+		return push(std::move(command));
+	}
+
+	bool Mixer::setStreamLoop(std::shared_ptr<MixerStream> stream, const bool loop) {
+		Command command;
+		command.op = Op::LOOP;
+		command.loop = loop;
+		command.stream = std::move(stream);
+		return push(std::move(command));
+	}
+
+	uint32_t Mixer::takeDropped() {
+		const auto dropped = _dropped;
+		_dropped = 0;
+		return dropped;
+	}
+
+	void Mixer::collect() {
+		std::shared_ptr<const void> resource;
+		while (_retired.pop(resource)) resource = nullptr;
+	}
+
+	void Mixer::start(MixerSink& sink) {
+		if (_running) return;
+		_running = true;
+		_sink = &sink;
+		_thread = std::thread(&Mixer::run, this, std::ref(sink));
+	}
+
+	void Mixer::stop() {
+		_running = false;
+		if (_thread.joinable()) _thread.join();
+		_sink = nullptr;
+	}
+
+	double Mixer::getLatency() const {
+		const auto* sink = _sink.load(std::memory_order_acquire);
+		return sink ? sink->getLatency() : 0.0;
+	}
+
+	void Mixer::render(int16_t* out, size_t frames) {
+		TRACE_ZONE("Mixer::render");
+		Command command;
+		while (_commands.pop(command)) process(command);
+
+		while (frames > 0) {
+			const auto chunk = std::min(frames, BLOCK_FRAMES);
+			std::fill(_accumulator.begin(), _accumulator.begin() + chunk * CHANNELS, 0);
+
+			mixVoices(_accumulator.data(), chunk);
+			mixStream(_accumulator.data(), chunk);
+
+			for (size_t i = 0; i < chunk * CHANNELS; i++) out[i] = clamp16(_accumulator[i]);
+			out += chunk * CHANNELS;
+			frames -= chunk;
+		}
+	}
+
+	bool Mixer::push(Command&& command) {
+		if (_commands.push(std::move(command))) return true;
+		_dropped++;
+		return false;
+	}
+
+	void Mixer::process(Command& command) {
+		if (command.op == Op::PLAY && command.pcm) {
+			// Take an idle voice, otherwise the oldest one. If this sound is already
+			// at its polyphony cap, steal the oldest voice that is playing it instead.
+			Voice* idle = nullptr;
+			Voice* oldest = nullptr;
+			Voice* oldestSame = nullptr;
+			auto playingSame = 0;
+			for (auto& voice : _voices) {
+				if (!voice.pcm) {
+					if (!idle) idle = &voice;
+					continue;
+				}
+
+				if (!oldest || voice.started < oldest->started) oldest = &voice;
+				if (voice.pcm == command.pcm) {
+					playingSame++;
+					if (!oldestSame || voice.started < oldestSame->started) oldestSame = &voice;
+				}
+			}
+
+			auto* voice = idle ? idle : oldest;
+			if (playingSame >= command.polyphony && oldestSame) voice = oldestSame;
+			retire(std::move(voice->pcm));
+			voice->pcm = std::move(command.pcm);
+			voice->position = 0;
+			voice->started = ++_started;
+		} else if (command.op == Op::PLAY && command.stream) {
+			if (command.stream != _stream) {
+				auto& stream = *command.stream;
+				if (_stream) _stream->_done.store(true, std::memory_order_release);
+				retire(std::move(_stream));
+
+				// Played to the end before, so start it over
+				if (stream._done.load(std::memory_order_relaxed)) {
+					stream.rewind();
+					stream._frames.store(0, std::memory_order_release);
+				}
+
+				const auto usable = (stream.getChannels() == 1 || stream.getChannels() == 2) &&
+					stream.getRate() > 0 && stream.getRate() <= RATE * MAX_STREAM_RATIO;
+				stream._done.store(!usable, std::memory_order_release);
+				if (usable) _stream = std::move(command.stream);
+				_streamPhase = 0;
+				_streamFrame = {};
+			}
+
+			_streamPlaying = _stream != nullptr;
+			_streamLoop = command.loop;
+		} else if (command.op == Op::PAUSE && command.stream == _stream) {
+			_streamPlaying = false;
+		} else if (command.op == Op::STOP && command.stream == _stream && _stream) {
+			_stream->_done.store(true, std::memory_order_release);
+			_streamPlaying = false;
+			retire(std::move(_stream));
+		} else if (command.op == Op::LOOP && command.stream == _stream) {
+			_streamLoop = command.loop;
+		}
+
+		// Whatever is left in the command gets freed on the game thread
+		retire(std::move(command.pcm));
+		retire(std::move(command.stream));
+		command.op = Op::NONE;
+	}
+
+	void Mixer::retire(std::shared_ptr<const void> resource) {
+		// If the queue is full it just gets freed here, which is not ideal but fine.
+		if (resource) _retired.push(std::move(resource));
+	}
+
+	void Mixer::mixVoices(int32_t* out, const size_t frames) {
+		auto playing = 0;
+		for (auto& voice : _voices) {
+			if (!voice.pcm) continue;
+
+			const auto& pcm = *voice.pcm;
+			const auto channels = pcm.channels;
+			const auto total = pcm.frames;
+			const uint64_t step = (static_cast<uint64_t>(pcm.rate) << 16) / RATE;
+
+			for (size_t i = 0; i < frames; i++) {
+				const auto index = voice.position >> 16;
+				if (index >= total) break;
+
+				const int32_t left = pcm.samples[index * channels];
+				const int32_t right = channels == 2 ? pcm.samples[index * channels + 1] : left;
+				out[i * CHANNELS] += left;
+				out[i * CHANNELS + 1] += right;
+				voice.position += step;
+			}
+
+			if ((voice.position >> 16) >= total) retire(std::move(voice.pcm));
+			else playing++;
+		}
+
+		_playing.store(playing + (_stream && _streamPlaying ? 1 : 0), std::memory_order_relaxed);
+	}
+
+	void Mixer::mixStream(int32_t* out, const size_t frames) {
+		if (!_stream || !_streamPlaying) return;
+		TRACE_ZONE("Mixer::mixStream");
+
+		auto& stream = *_stream;
+		const auto channels = stream.getChannels();
+		const uint64_t step = (static_cast<uint64_t>(stream.getRate()) << 16) / RATE;
+
+		// How many source frames this block steps through
+		const auto needed = static_cast<size_t>((_streamPhase + frames * step) >> 16);
+
+		size_t have = 0;
+		auto position = stream._frames.load(std::memory_order_relaxed);
+		auto rewound = false;
+		auto ended = false;
+		while (have < needed) {
+			const auto want = needed - have;
+			const auto read = stream.read(_decoded.data() + have * channels, want);
+			have += read;
+			position += read;
+			if (read == want) break;
+
+			// Either the end of the song, or a stream that can't produce anything
+			if (!_streamLoop || (read == 0 && rewound)) {
+				ended = true;
+				break;
+			}
+
+			stream.rewind();
+			position = 0;
+			rewound = true;
+		}
+
+		std::fill(_decoded.begin() + have * channels, _decoded.begin() + needed * channels, 0);
+
+		// Nearest neighbour, which is a no-op when the rates match
+		size_t next = 0;
+		uint64_t phase = _streamPhase;
+		for (size_t i = 0; i < frames; i++) {
+			out[i * CHANNELS] += _streamFrame[0];
+			out[i * CHANNELS + 1] += _streamFrame[1];
+			phase += step;
+			while (phase >= FIXED_ONE) {
+				phase -= FIXED_ONE;
+				_streamFrame[0] = _decoded[next * channels];
+				_streamFrame[1] = channels == 2 ? _decoded[next * channels + 1] : _streamFrame[0];
+				next++;
+			}
+		}
+
+		_streamPhase = static_cast<uint32_t>(phase);
+		stream._frames.store(position, std::memory_order_release);
+
+		if (ended) {
+			stream._done.store(true, std::memory_order_release);
+			_streamPlaying = false;
+			retire(std::move(_stream));
+		}
+	}
+
+	void Mixer::run(MixerSink& sink) {
+		TRACE_THREAD("mixer");
+		std::array<int16_t, BLOCK_FRAMES * CHANNELS> block{};
+		while (_running.load(std::memory_order_acquire)) {
+			render(block.data(), BLOCK_FRAMES);
+			TRACE_ZONE("Mixer::write");
+			sink.write(block.data(), BLOCK_FRAMES);
+		}
+	}
+}
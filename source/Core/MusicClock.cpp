@@ -0,0 +1,26 @@
+#include "../../include/Core/MusicClock.hpp"
+
+namespace SuperHaxagon {
+	double MusicClock::update(const double position, const double now, const double granularity) {
+		if (position != _position) {
+			_position = position;
+			_anchor = now;
+		}
+
+		auto time = _position + (now - _anchor);
+		if (time > _position + granularity) time = _position + granularity;
+
+		// The estimate overshot a little, wait for the output to catch up
+		// instead of going back in time and firing events twice.
+		if (time < _last && _last - time <= granularity) time = _last;
+
+		_last = time < 0 ? 0 : time;
+		return _last;
+	}
+
+	void MusicClock::reset() {
+		_position = -1.0;
+		_anchor = 0.0;
+		_last = 0.0;
+	}
+}
@@ -0,0 +1,55 @@
+#include "../../include/Core/Quality.hpp"
+
+namespace SuperHaxagon {
+	QualityController::QualityController(const double target, const size_t levels) :
+		_target(target),
+		_levels(levels > 0 ? levels : 1),
+		_average(target) {}
+
+	bool QualityController::update(const double frame) {
+		if (_settle > 0) {
+			_settle--;
+			_average = _target;
+			return false;
+		}
+
+		_average += (frame - _average) * SMOOTHING;
+
+		if (_average > _target * SLOW) {
+			_hold = 0;
+			if (++_slow < SLOW_FRAMES || _level + 1 >= _levels) return false;
+
+			// The level that was being tried didn't fit, wait longer before trying again
+			if (_probing && _probe < PROBE_FRAMES_MAX) _probe *= 2;
+			_probing = false;
+			return change(_level + 1);
+		}
+
+		_slow = 0;
+		if (_average > _target * HOLD) {
+			_hold = 0;
+			return false;
+		}
+
+		_hold++;
+		if (_probing && _hold >= PROBE_FRAMES) {
+			// Held up for a while, so it wasn't a fluke
+			_probing = false;
+			_probe = PROBE_FRAMES;
+			_hold = 0;
+		}
+
+		if (_probing || _level == 0 || _hold < _probe) return false;
+
+		_probing = true;
+		return change(_level - 1);
+	}
+
+	bool QualityController::change(const size_t level) {
+		_level = level;
+		_slow = 0;
+		_hold = 0;
+		_settle = SETTLE_FRAMES;
+		return true;
+	}
+}
@@ -0,0 +1,185 @@
+#include "../../include/Core/SoundBank.hpp"
+
+#include "../../include/Core/Trace.hpp"
+#include "../../include/Driver/Platform.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+namespace SuperHaxagon {
+	static const char* SOUND_NAMES[] = {
+		"begin", "hexagon", "over", "select", "level", "wonderful"
+	};
+
+	static_assert(sizeof(SOUND_NAMES) / sizeof(SOUND_NAMES[0]) == static_cast<size_t>(SoundId::LAST), "every sound needs a file");
+
+	// Where the samples of a WAV file are, and how they are stored
+	struct Wav {
+		std::string path;
+		std::streamoff offset = 0;
+		uint32_t bytes = 0;
+		uint16_t channels = 0;
+		uint16_t bits = 0;
+		uint32_t rate = 0;
+	};
+
+	template<class T>
+	static void read(std::ifstream& file, T& value) {
+		file.read(reinterpret_cast<char*>(&value), sizeof(value));
+	}
+
+	// Only looks at the headers, so this is quick enough to do for every file up front
+	static bool readHeader(Wav& wav) {
+		std::ifstream file(wav.path, std::ios::in | std::ios::binary);
+		char riff[12] = {};
+		file.read(riff, sizeof(riff));
+		if (!file || std::memcmp(riff, "RIFF", 4) != 0 || std::memcmp(riff + 8, "WAVE", 4) != 0) return false;
+
+		auto format = false;
+		while (file) {
+			char id[4] = {};
+			uint32_t size = 0;
+			file.read(id, sizeof(id));
+			read(file, size);
+			if (!file) return false;
+
+			const auto next = file.tellg() + static_cast<std::streamoff>(size + (size & 1));
+			if (std::memcmp(id, "fmt ", 4) == 0) {
+				uint16_t tag = 0;
+				read(file, tag);
+				read(file, wav.channels);
+				read(file, wav.rate);
+				file.seekg(6, std::ios::cur); // Byte rate and block align
+				read(file, wav.bits);
+				format = tag == 1; // PCM
+			} else if (std::memcmp(id, "data", 4) == 0) {
+				wav.offset = file.tellg();
+				wav.bytes = size;
+				return format && (wav.channels == 1 || wav.channels == 2) && (wav.bits == 8 || wav.bits == 16) && wav.rate > 0;
+			}
+
+			file.seekg(next);
+		}
+
+		return false;
+	}
+
+	// Runs on a loader thread, and only ever writes to its own slice of the arena
+	static bool decode(const Wav& wav, int16_t* out, const size_t frames, const uint32_t rate, const uint16_t channels) {
+		std::ifstream file(wav.path, std::ios::in | std::ios::binary);
+		file.seekg(wav.offset);
+		if (!file) return false;
+
+		const size_t sourceFrames = wav.bytes / (wav.bits / 8) / wav.channels;
+		const auto convert = rate != wav.rate || channels != wav.channels;
+
+		// Straight into the arena if nothing needs to change
+		if (!convert && wav.bits == 16) {
+			file.read(reinterpret_cast<char*>(out), sourceFrames * channels * sizeof(int16_t));
+			return static_cast<bool>(file);
+		}
+
+		std::vector<int16_t> source(sourceFrames * wav.channels);
+		if (wav.bits == 16) {
+			file.read(reinterpret_cast<char*>(source.data()), source.size() * sizeof(int16_t));
+		} else {
+			std::vector<uint8_t> bytes(source.size());
+			file.read(reinterpret_cast<char*>(bytes.data()), bytes.size());
+			for (size_t i = 0; i < bytes.size(); i++) source[i] = static_cast<int16_t>((bytes[i] - 128) * 256);
+		}
+
+		if (!file) return false;
+
+		if (!convert) {
+			std::memcpy(out, source.data(), source.size() * sizeof(int16_t));
+			return true;
+		}
+
+		// Linear interpolation between source frames, with mono duplicated
+		// to every channel and stereo averaged down to mono.
+		const auto sample = [&](const size_t frame, const uint16_t channel) {
+			const auto* in = &source[frame * wav.channels];
+			if (channels == 1 && wav.channels == 2) return (static_cast<int32_t>(in[0]) + in[1]) / 2;
+			return static_cast<int32_t>(in[channel < wav.channels ? channel : 0]);
+		};
+
+		const auto step = static_cast<double>(wav.rate) / rate;
+		for (size_t i = 0; i < frames; i++) {
+			const auto position = i * step;
+			const auto frame = static_cast<size_t>(position);
+			const auto next = frame + 1 < sourceFrames ? frame + 1 : frame;
+			const auto t = position - frame;
+			for (uint16_t channel = 0; channel < channels; channel++) {
+				const auto a = sample(frame, channel);
+				const auto b = sample(next, channel);
+				out[i * channels + channel] = static_cast<int16_t>(a + (b - a) * t);
+			}
+		}
+
+		return true;
+	}
+
+	SoundBank::SoundBank(Platform& platform, const uint32_t rate, const uint16_t channels) : _arena(nullptr, nullptr) {
+		constexpr auto count = static_cast<size_t>(SoundId::LAST);
+		std::array<Wav, count> wavs{};
+		std::array<size_t, count> offsets{};
+		size_t samples = 0;
+
+		// Size everything up first so the arena can be allocated once
+		for (size_t i = 0; i < count; i++) {
+			auto& wav = wavs[i];
+			wav.path = platform.getPathRom("/sound/") + SOUND_NAMES[i] + ".wav";
+			if (!readHeader(wav)) {
+				LOG_MESSAGEF(platform, Dbg::WARN, "sound", "failed to load %s", SOUND_NAMES[i]);
+				continue;
+			}
+
+			auto& sound = _sounds[i];
+			const size_t sourceFrames = wav.bytes / (wav.bits / 8) / wav.channels;
+			sound.rate = rate ? rate : wav.rate;
+			sound.channels = channels ? channels : wav.channels;
+			sound.frames = static_cast<size_t>(static_cast<uint64_t>(sourceFrames) * sound.rate / wav.rate);
+			offsets[i] = samples;
+			samples += sound.frames * sound.channels;
+		}
+
+		if (!samples) return;
+		_arena = platform.allocSFX(samples);
+		if (!_arena) {
+			LOG_MESSAGE(platform, Dbg::WARN, "sound", "failed to allocate sfx");
+			_sounds = {};
+			return;
+		}
+
+		_bytes = samples * sizeof(int16_t);
+
+		std::array<bool, count> decoded{};
+		std::vector<std::thread> loaders;
+		for (size_t i = 0; i < count; i++) {
+			if (!_sounds[i].frames) continue;
+			loaders.emplace_back([&, i]() {
+				TRACE_THREAD("sound bank");
+				TRACE_ZONE("SoundBank::decode");
+				const auto& sound = _sounds[i];
+				decoded[i] = decode(wavs[i], _arena.get() + offsets[i], sound.frames, sound.rate, sound.channels);
+			});
+		}
+
+		for (auto& loader : loaders) loader.join();
+
+		for (size_t i = 0; i < count; i++) {
+			if (!_sounds[i].frames) continue;
+			if (!decoded[i]) {
+				LOG_MESSAGEF(platform, Dbg::WARN, "sound", "failed to decode %s", SOUND_NAMES[i]);
+				_sounds[i] = {};
+				continue;
+			}
+
+			_sounds[i].samples = _arena.get() + offsets[i];
+		}
+	}
+
+	SoundBank::~SoundBank() = default;
+}
@@ -0,0 +1,72 @@
+#include "../../include/Core/Stats.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace SuperHaxagon {
+	static const char* STAT_NAMES[] = {
+		"POLY", "TRI", "VERT", "CALLS", "TEXT", "STATES", "SPAWNS", "RETIRED", "WALLS", "VOICES"
+	};
+
+	static_assert(sizeof(STAT_NAMES) / sizeof(STAT_NAMES[0]) == Stats::COUNT, "every stat needs a name");
+
+	// How many counters fit on one line of the overlay
+	static constexpr size_t STATS_PER_LINE = 3;
+
+	bool Stats::endFrame() {
+		_last = _current;
+		_current = {};
+		add(_report, _last);
+		add(_run, _last);
+		return _period && _report.frames >= _period;
+	}
+
+	void Stats::getLines(std::vector<std::string>& lines) const {
+		std::string line;
+		for (size_t i = 0; i < COUNT; i++) {
+			if (i % STATS_PER_LINE == 0 && !line.empty()) {
+				lines.emplace_back(line);
+				line.clear();
+			}
+
+			if (!line.empty()) line += "  ";
+			line += STAT_NAMES[i] + std::string(" ") + std::to_string(_last[i]);
+		}
+
+		lines.emplace_back(line);
+	}
+
+	std::string Stats::getReport() {
+		auto report = describe(_report);
+		_report = {};
+		return report;
+	}
+
+	std::string Stats::getSummary() const {
+		return describe(_run);
+	}
+
+	void Stats::add(Window& window, const Frame& frame) {
+		for (size_t i = 0; i < COUNT; i++) {
+			window.total[i] += frame[i];
+			window.peak[i] = std::max(window.peak[i], frame[i]);
+		}
+
+		window.frames++;
+	}
+
+	std::string Stats::describe(const Window& window) {
+		if (!window.frames) return "no frames";
+
+		// Average over peak for every counter
+		auto description = std::to_string(window.frames) + " frames";
+		char part[64];
+		for (size_t i = 0; i < COUNT; i++) {
+			const auto average = static_cast<double>(window.total[i]) / window.frames;
+			std::snprintf(part, sizeof(part), ", %s %.1f/%llu", STAT_NAMES[i], average, static_cast<unsigned long long>(window.peak[i]));
+			description += part;
+		}
+
+		return description;
+	}
+}
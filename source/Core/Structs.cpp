@@ -3,8 +3,7 @@
 #include "../../include/Driver/Platform.hpp"
 
 #include <cmath>
-#include <iomanip>
-#include <sstream>
+#include <cstdio>
 #include <string>
 
 namespace SuperHaxagon {
@@ -55,17 +54,58 @@ namespace SuperHaxagon {
 		return { point.x * c - point.y * s,  point.x * s + point.y * c };
 	}
 
+	Point transformPoint(const Transform& transform, const Point& point) {
+		return {
+			transform.xx * point.x + transform.xy * point.y + transform.tx,
+			transform.yx * point.x + transform.yy * point.y + transform.ty
+		};
+	}
+
+	Transform combine(const Transform& outer, const Transform& inner) {
+		return {
+			outer.xx * inner.xx + outer.xy * inner.yx,
+			outer.xx * inner.xy + outer.xy * inner.yy,
+			outer.xx * inner.tx + outer.xy * inner.ty + outer.tx,
+			outer.yx * inner.xx + outer.yy * inner.yx,
+			outer.yx * inner.xy + outer.yy * inner.yy,
+			outer.yx * inner.tx + outer.yy * inner.ty + outer.ty
+		};
+	}
+
+	Transform translate(const Point& offset) {
+		return {1, 0, offset.x, 0, 1, offset.y};
+	}
+
+	bool invert(const Transform& transform, Transform& inverse) {
+		const auto det = transform.xx * transform.yy - transform.xy * transform.yx;
+		if (std::abs(det) < 1e-12) return false;
+
+		inverse.xx = transform.yy / det;
+		inverse.xy = -transform.xy / det;
+		inverse.yx = -transform.yx / det;
+		inverse.yy = transform.xx / det;
+		inverse.tx = -(inverse.xx * transform.tx + inverse.xy * transform.ty);
+		inverse.ty = -(inverse.yx * transform.tx + inverse.yy * transform.ty);
+		return true;
+	}
+
 	std::string getTime(const double score) {
-		std::stringstream buffer;
+		char buffer[32];
+		formatTime(buffer, sizeof(buffer), score);
+		return buffer;
+	}
+
+	size_t formatTime(char* buffer, const size_t size, const double score) {
+		if (size == 0) return 0;
 		const auto scoreInt = static_cast<int>(score / 60.0);
 		const auto decimalPart = static_cast<int>((score / 60.0 - scoreInt) * 100.0);
-		buffer << std::fixed << std::setfill('0')
-			<< std::setprecision(3) << std::setw(3)
-			<< scoreInt
-			<< "."
-			<< std::setprecision(2) << std::setw(2)
-			<< decimalPart;
-		return buffer.str();
+		const auto written = std::snprintf(buffer, size, "%03d.%02d", scoreInt, decimalPart);
+		if (written < 0) {
+			buffer[0] = '\0';
+			return 0;
+		}
+
+		return static_cast<size_t>(written) < size ? written : size - 1;
 	}
 
 	double getPulse(double frame, const double range, const double start) {
@@ -101,12 +141,12 @@ namespace SuperHaxagon {
 
 		if (num < min) {
 			num = min;
-			platform.message(Dbg::WARN, "int", noun + " is too small, but continuing anyway.");
+			LOG_MESSAGEF(platform, Dbg::WARN, "int", "%s is too small, but continuing anyway.", noun.c_str());
 		}
 
 		if (num > max) {
 			num = max;
-			platform.message(Dbg::WARN, "int", noun + " is too large, but continuing anyway.");
+			LOG_MESSAGEF(platform, Dbg::WARN, "int", "%s is too large, but continuing anyway.", noun.c_str());
 		}
 
 		return num;
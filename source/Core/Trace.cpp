@@ -0,0 +1,100 @@
+#include "../../include/Core/Trace.hpp"
+
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace SuperHaxagon {
+	using TraceClock = std::chrono::steady_clock;
+
+	struct TraceEvent {
+		const char* name;
+		TraceClock::time_point start;
+		TraceClock::duration duration;
+	};
+
+	/**
+	 * One per thread, a ring that overwrites its oldest zones once it's full.
+	 * The lock is only ever fought over while a trace is being written.
+	 */
+	struct TraceBuffer {
+		std::mutex lock;
+		std::vector<TraceEvent> events;
+		size_t next = 0;
+		size_t id = 0;
+		const char* name = nullptr;
+	};
+
+	// Buffers outlive their threads, the sound bank's decoders are long gone by the time a trace is written
+	static std::mutex traceLock;
+	static std::vector<std::unique_ptr<TraceBuffer>> traceBuffers;
+	static const auto traceStart = TraceClock::now();
+	static thread_local TraceBuffer* traceBuffer = nullptr;
+
+	static TraceBuffer& getTraceBuffer() {
+		if (traceBuffer) return *traceBuffer;
+
+		std::lock_guard<std::mutex> guard(traceLock);
+		traceBuffers.emplace_back(std::make_unique<TraceBuffer>());
+		traceBuffer = traceBuffers.back().get();
+		traceBuffer->events.reserve(TRACE_EVENTS);
+		traceBuffer->id = traceBuffers.size();
+		return *traceBuffer;
+	}
+
+	static double toMicroseconds(const TraceClock::duration duration) {
+		return std::chrono::duration<double, std::micro>(duration).count();
+	}
+
+	TraceZone::~TraceZone() {
+		const auto end = TraceClock::now();
+		auto& buffer = getTraceBuffer();
+		std::lock_guard<std::mutex> guard(buffer.lock);
+		if (buffer.events.size() < TRACE_EVENTS) {
+			buffer.events.push_back({_name, _start, end - _start});
+			return;
+		}
+
+		buffer.events[buffer.next] = {_name, _start, end - _start};
+		buffer.next = (buffer.next + 1) % TRACE_EVENTS;
+	}
+
+	void setTraceThread(const char* name) {
+		auto& buffer = getTraceBuffer();
+		std::lock_guard<std::mutex> guard(buffer.lock);
+		buffer.name = name;
+	}
+
+	bool writeTrace(const std::string& path) {
+		std::ofstream out(path);
+		if (!out) return false;
+
+		// Names are always literals from the zones, so nothing needs escaping
+		out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+		out.precision(3);
+		out << std::fixed;
+
+		auto first = true;
+		std::lock_guard<std::mutex> guard(traceLock);
+		for (const auto& buffer : traceBuffers) {
+			std::lock_guard<std::mutex> bufferGuard(buffer->lock);
+			if (buffer->name) {
+				out << (first ? "" : ",\n") << R"({"ph":"M","name":"thread_name","pid":1,"tid":)" << buffer->id << R"(,"args":{"name":")" << buffer->name << "\"}}";
+				first = false;
+			}
+
+			// Oldest first, which is where the ring is about to write next
+			const auto count = buffer->events.size();
+			for (size_t i = 0; i < count; i++) {
+				const auto& event = buffer->events[(buffer->next + i) % count];
+				out << (first ? "" : ",\n") << R"({"ph":"X","name":")" << event.name << R"(","pid":1,"tid":)" << buffer->id
+					<< ",\"ts\":" << toMicroseconds(event.start - traceStart) << ",\"dur\":" << toMicroseconds(event.duration) << "}";
+				first = false;
+			}
+		}
+
+		out << "\n]}\n";
+		return out.good();
+	}
+}
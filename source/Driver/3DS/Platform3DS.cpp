@@ -1,11 +1,13 @@
 #include "Driver/3DS/Platform3DS.hpp"
 
 #include "Core/Structs.hpp"
+#include "Core/Trace.hpp"
 #include "Core/Twist.hpp"
 #include "Driver/3DS/AudioOgg3DS.hpp"
 #include "Driver/3DS/AudioWav3DS.hpp"
 #include "Driver/3DS/Font3DS.hpp"
 #include "Driver/3DS/PlayerOgg3DS.hpp"
+#include "Driver/3DS/PlayerWav3DS.hpp"
 
 #include <array>
 #include <iostream>
@@ -85,10 +87,15 @@ namespace SuperHaxagon {
 		C3D_FrameEnd(0);
 	}
 
+	void Platform3DS::vmessage(const Dbg dbg, const char* where, const char* format, va_list args) {
+		_log.vpush(dbg, where, format, args);
+	}
+
 	Platform3DS::~Platform3DS() {
 		// Call d'tors before filesystem and audio shutdown.
 		for (auto& track : _sfx) track = nullptr;
 		_bgm = nullptr;
+		_sounds = nullptr;
 		C2D_Fini();
 		C3D_Fini();
 		gfxExit();
@@ -126,13 +133,23 @@ namespace SuperHaxagon {
 		return std::make_unique<Font3DS>(path, size, _buff);
 	}
 
+	SoundBank::Arena Platform3DS::allocSFX(const size_t samples) {
+		// The DSP can only read from linear memory
+		return {static_cast<int16_t*>(linearAlloc(samples * sizeof(int16_t))), [](int16_t* data) {linearFree(data);}};
+	}
+
 	// Note: If there are no available channels the audio is silently discarded
-	void Platform3DS::playSFX(Audio& audio) {
+	void Platform3DS::playSFX(const SoundId id) {
+		const auto& sound = _sounds->get(id);
+		if (!sound.samples) return;
+
 		auto channel = 1;
 		for (auto& player : _sfx) {
 			if (!player || player->isDone()) {
-				player = audio.instantiate();
-				if (!player) return;
+				const auto format = sound.channels == 1 ? NDSP_FORMAT_MONO_PCM16 : NDSP_FORMAT_STEREO_PCM16;
+				auto* data = reinterpret_cast<u8*>(const_cast<int16_t*>(sound.samples));
+				const auto size = sound.frames * sound.channels * sizeof(int16_t);
+				player = std::make_unique<PlayerWav3DS>(data, sound.rate, size, sound.channels, 16, format);
 				player->setChannel(channel);
 				player->setLoop(false);
 				player->play();
@@ -193,18 +210,32 @@ namespace SuperHaxagon {
 	}
 
 	void Platform3DS::screenFinalize() {
+		TRACE_ZONE("Platform3DS::present");
 		C3D_FrameEnd(0);
 	}
 
+	void Platform3DS::screenSkip() {
+		// C3D_FrameBegin is what usually waits for the screen
+		gspWaitForVBlank();
+	}
+
 	void Platform3DS::drawPoly(const Color& color, const std::vector<Point>& points) {
+		if (points.size() < 3) return;
+		_stats.addPoly(points.size());
+
 		const auto c = C2D_Color32(color.r, color.g, color.b, color.a);
+		const auto& transform = getTransform();
+		const auto first = transformPoint(transform, points[0]);
+		auto last = transformPoint(transform, points[1]);
 		for (size_t i = 1; i < points.size() - 1; i++) {
+			const auto next = transformPoint(transform, points[i + 1]);
 			C2D_DrawTriangle(
-				static_cast<float>(points[0].x), static_cast<float>(points[0].y), c,
-				static_cast<float>(points[i].x), static_cast<float>(points[i].y), c,
-				static_cast<float>(points[i + 1].x), static_cast<float>(points[i + 1].y), c,
+				static_cast<float>(first.x), static_cast<float>(first.y), c,
+				static_cast<float>(last.x), static_cast<float>(last.y), c,
+				static_cast<float>(next.x), static_cast<float>(next.y), c,
 				0
 			);
+			last = next;
 		}
 	}
 
@@ -217,6 +248,8 @@ namespace SuperHaxagon {
 	}
 
 	void Platform3DS::shutdown() {
+		_log.stop();
+
 		auto display = false;
 		for (const auto& message : _messages) {
 			if (message.first == Dbg::FATAL) {
@@ -255,23 +288,17 @@ namespace SuperHaxagon {
 	}
 
 	void Platform3DS::message(const Dbg dbg, const std::string& where, const std::string& message) {
-		std::string format;
-		if (dbg == Dbg::INFO) {
-			format = "[3ds:info] ";
-		} else if (dbg == Dbg::WARN) {
-			format = "[3ds:warn] ";
-		} else if (dbg == Dbg::FATAL) {
-			format = "[3ds:fatal] ";
-		}
-
-		format += where + ": " + message;
+		_log.push(dbg, where, message);
+	}
 
+	void Platform3DS::keep(const Dbg dbg, const std::string& line, const bool last) {
 		if (_dbg != Dbg::FATAL) {
 			// If we are in non FATAL mode, there's a console to print to
-			std::cout << format << std::endl;
+			std::cout << line << '\n';
+			if (last) std::cout.flush();
 		}
 
-		_messages.emplace_back(dbg, format);
+		_messages.emplace_back(dbg, line);
 		if (_messages.size() > 32) _messages.pop_front();
 	}
 }
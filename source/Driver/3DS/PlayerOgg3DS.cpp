@@ -61,11 +61,11 @@ namespace SuperHaxagon {
 	void PlayerOgg3DS::play() {
 		if (!_loaded) return;
 
+		_playing = true;
+
 		if (_thread) {
-			if (_diff) _start += svcGetSystemTick() - _diff;
 			ndspChnSetPaused(_channel, false);
 			LightEvent_Signal(&_event);
-			_diff = 0;
 			return;
 		}
 
@@ -83,12 +83,11 @@ namespace SuperHaxagon {
 
 		// Start the thread, passing the player as an argument.
 		_thread = threadCreate(audioThread, this, THREAD_STACK_SZ, priority, THREAD_AFFINITY, false);
-		_start = svcGetSystemTick();
 	}
 
 	void PlayerOgg3DS::pause() {
 		ndspChnSetPaused(_channel, true);
-		_diff = svcGetSystemTick();
+		_playing = false;
 	}
 
 	bool PlayerOgg3DS::isDone() const {
@@ -98,11 +97,28 @@ namespace SuperHaxagon {
 	double PlayerOgg3DS::getTime() const {
 		if (!_loaded) return 0;
 
-		// If we set diff (paused), we are frozen in time. Otherwise, the current timestamp is
-		// the system minus the start of the song.
-		const auto ticks = _diff ? _diff - _start : svcGetSystemTick() - _start;
-		const auto timeMs = static_cast<double>(ticks) / CPU_TICKS_PER_MSEC;
-		return timeMs / 1000.0;
+		// Frozen in time while paused
+		if (!_playing) return _clock.get();
+
+		// Find the buffer the DSP is in the middle of. Its start frame is only
+		// rewritten by the audio thread once the DSP is done with it.
+		const auto sequence = ndspChnGetWaveBufSeq(_channel);
+		for (size_t i = 0; i < _waveBuffs.size(); i++) {
+			const auto& waveBuff = _waveBuffs[i];
+			if (waveBuff.status != NDSP_WBUF_PLAYING || waveBuff.sequence_id != sequence) continue;
+
+			const auto frames = _waveBuffStart[i] + ndspChnGetSamplePos(_channel);
+			const auto position = static_cast<double>(frames) / _oggFile->sample_rate - getLatency();
+			const auto now = static_cast<double>(svcGetSystemTick()) / CPU_TICKS_PER_MSEC / 1000.0;
+			return _clock.update(position, now, DSP_FRAME);
+		}
+
+		// In between buffers, or the decoder fell behind
+		return _clock.get();
+	}
+
+	double PlayerOgg3DS::getLatency() const {
+		return DSP_FRAME;
 	}
 
 	bool PlayerOgg3DS::audioDecode(stb_vorbis* file, ndspWaveBuf* buff, const int channel) {
@@ -134,9 +150,14 @@ namespace SuperHaxagon {
 		if (!pointer) return;
 
 		while(!pointer->_quit) {
-			for (auto& waveBuff : pointer->_waveBuffs) {
+			for (size_t i = 0; i < pointer->_waveBuffs.size(); i++) {
+				auto& waveBuff = pointer->_waveBuffs[i];
 				if (waveBuff.status != NDSP_WBUF_DONE) continue;
-				if (!audioDecode(pointer->_oggFile, &waveBuff, pointer->_channel)) {
+
+				pointer->_waveBuffStart[i] = pointer->_decoded;
+				if (audioDecode(pointer->_oggFile, &waveBuff, pointer->_channel)) {
+					pointer->_decoded += waveBuff.nsamples;
+				} else {
 					if (!pointer->_loop) {
 						pointer->_quit = true;
 						return;
@@ -144,7 +165,7 @@ namespace SuperHaxagon {
 
 					// We are looping, so go back to the beginning
 					stb_vorbis_seek_start(pointer->_oggFile);
-					pointer->_start = svcGetSystemTick();
+					pointer->_decoded = 0;
 				}
 			}
 
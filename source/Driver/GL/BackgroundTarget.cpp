@@ -0,0 +1,123 @@
+#include "../../../include/Driver/GL/BackgroundTarget.hpp"
+
+#include "../../../include/Driver/Platform.hpp"
+
+#include <cmath>
+
+// Corners come from gl_VertexID, f_position is in the same pixels the game draws in
+static const char* vertex_shader = R"text(
+#version 330 core
+
+out vec2 f_position;
+
+uniform vec2 s_screen;
+uniform float b_z;
+
+void main() {
+	vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));
+	f_position = corner * s_screen;
+	gl_Position = vec4(corner.x * 2.0 - 1.0, 1.0 - corner.y * 2.0, b_z, 1.0);
+}
+)text";
+
+static const char* fragment_shader = R"text(
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+in vec2 f_position;
+
+uniform vec2 s_screen;
+uniform vec2 b_focus;
+uniform float b_distance;
+uniform float b_rotation;
+uniform float b_sides;
+uniform mat3 b_inverse;
+uniform vec4 b_color1;
+uniform vec4 b_color2;
+uniform vec4 b_color3;
+
+const float PI = 3.14159265358979;
+const float TAU = PI * 2.0;
+
+void main() {
+	// The triangles were transformed after they were built, so undo that first
+	vec2 d = (b_inverse * vec3(f_position, 1.0)).xy - b_focus;
+
+	// Edges are at rotation + i * sector, with y pointing down
+	float sector = TAU / b_sides;
+	float last = ceil(b_sides) - 1.0;
+	float angle = mod(atan(-d.y, d.x) - b_rotation, TAU);
+	float i = min(floor(angle / sector), last);
+
+	// The last triangle closes the gap back to the first edge, which
+	// is narrower than the others while the side count is tweening
+	float start = i * sector;
+	float end = i == last ? TAU : start + sector;
+	float middle = (start + end) * 0.5;
+	float spread = (end - start) * 0.5;
+
+	// Past the far edge of its triangle only the solid background is left
+	bool inside = length(d) * cos(angle - middle) <= b_distance * cos(spread);
+
+	color = b_color1;
+	if (inside && mod(i, 2.0) < 0.5) color = i == last ? b_color3 : b_color2;
+}
+)text";
+
+namespace SuperHaxagon {
+	BackgroundTarget::BackgroundTarget(Platform& platform) {
+		_program = linkProgram(platform, vertex_shader, fragment_shader);
+		glUseProgram(_program);
+
+		_uniformScreen = glGetUniformLocation(_program, "s_screen");
+		_uniformFocus = glGetUniformLocation(_program, "b_focus");
+		_uniformDistance = glGetUniformLocation(_program, "b_distance");
+		_uniformRotation = glGetUniformLocation(_program, "b_rotation");
+		_uniformSides = glGetUniformLocation(_program, "b_sides");
+		_uniformInverse = glGetUniformLocation(_program, "b_inverse");
+		_uniformZ = glGetUniformLocation(_program, "b_z");
+		_uniformColor1 = glGetUniformLocation(_program, "b_color1");
+		_uniformColor2 = glGetUniformLocation(_program, "b_color2");
+		_uniformColor3 = glGetUniformLocation(_program, "b_color3");
+
+		// Core profile still wants a vertex array bound, even with no attributes
+		glGenVertexArrays(1, &_vao);
+	}
+
+	BackgroundTarget::~BackgroundTarget() {
+		glDeleteVertexArrays(1, &_vao);
+		glDeleteProgram(_program);
+	}
+
+	void BackgroundTarget::insert(const Color& color1, const Color& color2, const Color& color3, const BackgroundTransform& transform, const Transform& inverse, const uint16_t z) {
+		_batches.push_back({color1, color2, color3, transform, inverse, z});
+	}
+
+	void BackgroundTarget::draw(Platform& platform) {
+		if (_batches.empty()) return;
+
+		glUseProgram(_program);
+		glBindVertexArray(_vao);
+
+		const auto screen = platform.getScreenDim();
+		glUniform2f(_uniformScreen, static_cast<float>(screen.x), static_cast<float>(screen.y));
+
+		for (const auto& batch : _batches) {
+			const auto& t = batch.transform;
+			glUniform2f(_uniformFocus, static_cast<float>(t.focus.x), static_cast<float>(t.focus.y));
+			glUniform1f(_uniformDistance, static_cast<float>(t.distance));
+			glUniform1f(_uniformRotation, static_cast<float>(std::fmod(t.rotation, TAU)));
+			glUniform1f(_uniformSides, static_cast<float>(t.sides));
+			uploadTransform(_uniformInverse, batch.inverse);
+			glUniform1f(_uniformZ, batch.z / 65535.0f);
+			glUniform4f(_uniformColor1, batch.color1.r / 255.0f, batch.color1.g / 255.0f, batch.color1.b / 255.0f, 1.0f);
+			glUniform4f(_uniformColor2, batch.color2.r / 255.0f, batch.color2.g / 255.0f, batch.color2.b / 255.0f, 1.0f);
+			glUniform4f(_uniformColor3, batch.color3.r / 255.0f, batch.color3.g / 255.0f, batch.color3.b / 255.0f, 1.0f);
+			glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+			platform.getStats().add(Stat::DRAW_CALLS);
+		}
+
+		_batches.clear();
+	}
+}
@@ -0,0 +1,103 @@
+#include "../../../include/Driver/GL/FontGL.hpp"
+
+#include "../../../include/Driver/GL/PlatformGL.hpp"
+
+static auto* vertex_shader = R"text(
+#version 330 core
+
+layout(location = 0) in vec2 v_position;
+layout(location = 1) in vec2 v_uv;
+layout(location = 2) in vec4 v_color;
+layout(location = 3) in float v_z;
+
+out vec2 f_uv;
+out vec4 f_color;
+
+uniform float s_width;
+uniform float s_height;
+
+void main() {
+	float x_norm = (v_position.x / s_width - 0.5) * 2.0;
+	float y_norm = (v_position.y / s_height - 0.5) * -2.0;
+
+	gl_Position = vec4(x_norm, y_norm, v_z, 1.0);
+	f_color = v_color;
+	f_uv = v_uv;
+}
+)text";
+
+static auto* fragment_shader = R"text(
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+uniform sampler2D f_tex;
+in vec4 f_color;
+in vec2 f_uv;
+
+void main() {
+	color = vec4(1.0, 1.0, 1.0, texture2D(f_tex, f_uv).r) * f_color;
+}
+)text";
+
+namespace SuperHaxagon {
+	FontGL::FontGL(PlatformGL& platform, const std::string& path, const double size) :
+		_platform(platform),
+		_atlas(path + ".ttf", size * 2) {
+		if (!_atlas.isLoaded()) {
+			platform.message(Dbg::FATAL, "font", "could not load font " + path + ".ttf");
+			return;
+		}
+
+		_surface = std::make_shared<RenderTarget<VertexUV>>(platform, true, vertex_shader, fragment_shader, path);
+		_surface->bind();
+
+		platform.addRenderTarget(_surface);
+
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, _atlas.getTextureWidth(), _atlas.getTextureHeight(), 0, GL_RED, GL_UNSIGNED_BYTE, _atlas.getPixels().data());
+	}
+
+	FontGL::~FontGL() = default;
+
+	double FontGL::getHeight() const {
+		return _atlas.getAscent();
+	}
+
+	double FontGL::getWidth(const std::string& text) const {
+		return _atlas.getWidth(text);
+	}
+
+	void FontGL::draw(const Color& color, const Point& position, Alignment alignment, const std::string& text) {
+		if (!_atlas.isLoaded()) return;
+		_platform.getStats().add(Stat::TEXT_DRAWS);
+
+		Point cursor = position;
+		const auto width = getWidth(text);
+		if (alignment == Alignment::CENTER) cursor.x = position.x - width / 2;
+		if (alignment == Alignment::RIGHT) cursor.x = position.x - width;
+
+		_quads.clear();
+		_atlas.layout(text, cursor, _quads);
+
+		const auto z = _platform.getAndIncrementZ();
+		for (const auto& quad : _quads) {
+			const auto& p = quad.position;
+			const auto& d = quad.size;
+			_surface->insert({{p.x, p.y + d.y}, {quad.uv0.x, quad.uv1.y}, color, z}); // BL
+			_surface->insert({{p.x, p.y}, {quad.uv0.x, quad.uv0.y}, color, z}); // TL
+			_surface->insert({{p.x + d.x, p.y}, {quad.uv1.x, quad.uv0.y}, color, z}); // TR
+			_surface->insert({{p.x + d.x, p.y + d.y}, {quad.uv1.x, quad.uv1.y}, color, z}); // BR
+
+			// Insert clockwise
+			_surface->reference(0);
+			_surface->reference(1);
+			_surface->reference(2);
+			_surface->reference(0);
+			_surface->reference(2);
+			_surface->reference(3);
+
+			_surface->advance(4);
+		}
+	}
+}
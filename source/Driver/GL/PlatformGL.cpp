@@ -0,0 +1,308 @@
+#include "../../../include/Driver/GL/PlatformGL.hpp"
+
+#include "../../../include/Core/Trace.hpp"
+#include "../../../include/Driver/GL/FontGL.hpp"
+
+#include <EGL/eglext.h>
+
+#include <sstream>
+
+static const char* vertex_shader = R"text(
+#version 330 core
+
+layout(location = 0) in vec2 v_position;
+layout(location = 1) in vec4 v_color;
+layout(location = 2) in float v_z;
+
+out vec4 f_color;
+
+uniform float s_width;
+uniform float s_height;
+
+void main() {
+	float x_norm = (v_position.x / s_width - 0.5) * 2.0;
+	float y_norm = (v_position.y / s_height - 0.5) * -2.0;
+
+	gl_Position = vec4(x_norm, y_norm, v_z, 1.0);
+	f_color = v_color;
+}
+)text";
+
+static const char* fragment_shader = R"text(
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+in vec4 f_color;
+
+void main() {
+	color = f_color;
+}
+)text";
+
+/**
+ * Helper function used for debugging OpenGL
+ */
+static void callback(const GLenum source, const GLenum type, const GLuint id, const GLenum severity, GLsizei, const GLchar* message, const void* userParam) {
+	// WCGW casting away const-ness?
+	auto* platform = const_cast<SuperHaxagon::PlatformGL*>(static_cast<const SuperHaxagon::PlatformGL*>(userParam));
+	const auto error = type == GL_DEBUG_TYPE_ERROR;
+	std::stringstream out;
+	out << std::hex << "Message from OpenGL:" << std::endl;
+	out << "Source: 0x" << source << std::endl;
+	out << "Type: 0x" << type << (error ? " (GL ERROR)" : "") << std::endl;
+	out << "ID: 0x" << id << std::endl;
+	out << "Severity: 0x" << severity << std::endl;
+	out << message;
+	LOG_MESSAGE(*platform, error ? SuperHaxagon::Dbg::FATAL : SuperHaxagon::Dbg::INFO, "opengl", out.str());
+}
+
+namespace SuperHaxagon {
+	PlatformGL::PlatformGL(const Dbg dbg) : Platform(dbg) {}
+
+	PlatformGL::~PlatformGL() = default;
+
+	std::unique_ptr<Font> PlatformGL::loadFont(const std::string& path, int size) {
+		return std::make_unique<FontGL>(*this, path, size);
+	}
+
+	Point PlatformGL::getScreenDim() const {
+		return Point{static_cast<double>(_width), static_cast<double>(_height)};
+	}
+
+	void PlatformGL::screenBegin() {
+		_z = 0;
+		glClearColor(0.2f, 0.3f, 0.8f, 1.0f);
+		glClearDepth(0.0f);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	}
+
+	void PlatformGL::screenSwap() {
+		// Nothing to do, every GL driver only has one screen
+	}
+
+	void PlatformGL::screenFinalize() {
+		// Want to render opaque first, then transparent. Walls go before the other
+		// transparent targets since their shadows are always drawn underneath.
+		// The background is the furthest back, so it goes last of the opaque
+		// targets and the depth test skips every pixel that is already covered.
+		{
+			TRACE_ZONE("PlatformGL::batches");
+			render(_targetVertex, false);
+			render(_targetVertexUV, false);
+			_opaqueWalls->draw(*this);
+			_background->draw(*this);
+			_transparentWalls->draw(*this);
+			render(_targetVertex, true);
+			render(_targetVertexUV, true);
+		}
+
+		TRACE_ZONE("PlatformGL::present");
+
+		// Swapping a pbuffer does nothing, so wait for the frame to actually finish
+		// instead. Otherwise a headless run would just queue up work forever.
+		if (_offscreen) glFinish();
+		else eglSwapBuffers(_display, _surface);
+	}
+
+	void PlatformGL::drawPoly(const Color& color, const std::vector<Point>& points) {
+		_stats.addPoly(points.size());
+		const auto z = getAndIncrementZ();
+		const auto& transform = getTransform();
+		auto& buffer = color.a == 0xFF || color.a == 0 ? _opaque : _transparent;
+		for (const auto& point : points) {
+			buffer->insert({transformPoint(transform, point), color, z});
+		}
+
+		for (size_t i = 1; i < points.size() - 1; i++) {
+			buffer->reference(0);
+			buffer->reference(i);
+			buffer->reference(i + 1);
+		}
+
+		buffer->advance(points.size());
+	}
+
+	bool PlatformGL::drawStrip(const Color& color, const std::vector<Point>& points) {
+		_stats.addPoly(points.size());
+		const auto z = getAndIncrementZ();
+		const auto& transform = getTransform();
+		auto& buffer = color.a == 0xFF || color.a == 0 ? _opaque : _transparent;
+		for (const auto& point : points) {
+			buffer->insert({transformPoint(transform, point), color, z});
+		}
+
+		for (size_t i = 2; i < points.size(); i++) {
+			buffer->reference(i - 2);
+			buffer->reference(i - 1);
+			buffer->reference(i);
+		}
+
+		buffer->advance(points.size());
+		return true;
+	}
+
+	bool PlatformGL::drawWalls(const Color& color, const WallTransform& transform, const std::vector<WallInstance>& walls) {
+		if (!_instancedWalls) return false;
+		for (const auto& wall : walls) _stats.addPoly((wall.count + 1) * 2);
+		auto& target = color.a == 0xFF || color.a == 0 ? _opaqueWalls : _transparentWalls;
+		target->insert(color, transform, getTransform(), getAndIncrementZ(), walls);
+		return true;
+	}
+
+	bool PlatformGL::drawBackground(const Color& color1, const Color& color2, const Color& color3, const BackgroundTransform& transform) {
+		// The shader only knows how to fill every pixel once, so anything that blends has to use triangles
+		if (!_shaderBackground || color1.a != 0xFF || color2.a != 0xFF || color3.a != 0xFF) return false;
+
+		// It works backwards from the pixel, so it needs the transform undone
+		Transform inverse{};
+		if (!invert(getTransform(), inverse)) return false;
+		_stats.addPoly(4);
+		_background->insert(color1, color2, color3, transform, inverse, getAndIncrementZ());
+		return true;
+	}
+
+	uint16_t PlatformGL::getAndIncrementZ() {
+		const auto z = _z;
+		if (_z < UINT16_MAX) _z++;
+		return z;
+	}
+
+	bool PlatformGL::initGL(const EGLDisplay display, const EGLNativeWindowType window, const int major, const int minor) {
+		_display = display;
+		_offscreen = !window;
+
+		if (!eglInitialize(_display, nullptr, nullptr)) {
+			message(Dbg::FATAL, "display", "error " + std::to_string(eglGetError()));
+			return false;
+		}
+
+		if (eglBindAPI(EGL_OPENGL_API) == EGL_FALSE) {
+			message(Dbg::FATAL, "api", "error " + std::to_string(eglGetError()));
+			eglTerminate(_display);
+			return false;
+		}
+
+		const EGLint framebufferAttributes[] = {
+			EGL_SURFACE_TYPE,    _offscreen ? EGL_PBUFFER_BIT : EGL_WINDOW_BIT,
+			EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+			EGL_RED_SIZE,        8,
+			EGL_GREEN_SIZE,      8,
+			EGL_BLUE_SIZE,       8,
+			EGL_ALPHA_SIZE,      8,
+			EGL_DEPTH_SIZE,      24,
+			EGL_STENCIL_SIZE,    8,
+			EGL_NONE
+		};
+
+		const EGLint contextAttributes[] = {
+			EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR,
+			EGL_CONTEXT_MAJOR_VERSION_KHR, major,
+			EGL_CONTEXT_MINOR_VERSION_KHR, minor,
+			EGL_NONE
+		};
+
+		EGLConfig config;
+		EGLint numConfigs = 0;
+
+		eglChooseConfig(_display, framebufferAttributes, &config, 1, &numConfigs);
+		if (numConfigs == 0) {
+			message(Dbg::FATAL, "config", "error " + std::to_string(eglGetError()));
+			eglTerminate(_display);
+			return false;
+		}
+
+		if (_offscreen) {
+			const EGLint pbufferAttributes[] = {
+				EGL_WIDTH, static_cast<EGLint>(_width),
+				EGL_HEIGHT, static_cast<EGLint>(_height),
+				EGL_NONE
+			};
+
+			_surface = eglCreatePbufferSurface(_display, config, pbufferAttributes);
+		} else {
+			_surface = eglCreateWindowSurface(_display, config, window, nullptr);
+		}
+
+		if (_surface == EGL_NO_SURFACE) {
+			message(Dbg::FATAL, "surface", "error " + std::to_string(eglGetError()));
+			eglTerminate(_display);
+			return false;
+		}
+
+		_context = eglCreateContext(_display, config, EGL_NO_CONTEXT, contextAttributes);
+		if (_context == EGL_NO_CONTEXT) {
+			message(Dbg::FATAL, "context", "error " + std::to_string(eglGetError()));
+			eglDestroySurface(_display, _surface);
+			eglTerminate(_display);
+			return false;
+		}
+
+		eglMakeCurrent(_display, _surface, _surface, _context);
+
+		#ifdef __SWITCH__
+		gladLoadGL();
+		#endif
+
+		// Debug output is only core since 4.3
+		GLint versionMajor = 0;
+		GLint versionMinor = 0;
+		glGetIntegerv(GL_MAJOR_VERSION, &versionMajor);
+		glGetIntegerv(GL_MINOR_VERSION, &versionMinor);
+		if (versionMajor > 4 || (versionMajor == 4 && versionMinor >= 3)) {
+			glEnable(GL_DEBUG_OUTPUT);
+			glDebugMessageCallback(callback, this);
+		}
+
+		message(Dbg::INFO, "opengl", reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+		message(Dbg::INFO, "opengl", reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+
+		glEnable(GL_DEPTH_TEST);
+		glEnable(GL_FRAMEBUFFER_SRGB);
+		glDepthMask(GL_TRUE);
+		glDepthFunc(GL_GREATER);
+		glDepthRange(0.0f, 1.0f);
+		glViewport(0, 0, _width, _height);
+
+		_opaque = std::make_shared<RenderTarget<Vertex>>(*this, false, vertex_shader, fragment_shader, "platform opaque");
+		_transparent = std::make_shared<RenderTarget<Vertex>>(*this, true, vertex_shader, fragment_shader, "platform transparent");
+		addRenderTarget(_opaque);
+		addRenderTarget(_transparent);
+
+		_opaqueWalls = std::make_unique<WallTarget>(*this, false);
+		_transparentWalls = std::make_unique<WallTarget>(*this, true);
+		_background = std::make_unique<BackgroundTarget>(*this);
+
+		return true;
+	}
+
+	void PlatformGL::destroyGL() {
+		if (_display == EGL_NO_DISPLAY) return;
+
+		// The targets own GL objects, so they have to go while there is still a context
+		_opaque = nullptr;
+		_transparent = nullptr;
+		_opaqueWalls = nullptr;
+		_transparentWalls = nullptr;
+		_background = nullptr;
+		_targetVertex.clear();
+		_targetVertexUV.clear();
+
+		eglMakeCurrent(_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+		if (_context != EGL_NO_CONTEXT) eglDestroyContext(_display, _context);
+		if (_surface != EGL_NO_SURFACE) eglDestroySurface(_display, _surface);
+		eglTerminate(_display);
+
+		_context = EGL_NO_CONTEXT;
+		_surface = EGL_NO_SURFACE;
+		_display = EGL_NO_DISPLAY;
+	}
+
+	template<class T>
+	void PlatformGL::render(const std::deque<std::shared_ptr<RenderTarget<T>>>& targets, const bool transparent) {
+		for (const auto& target : targets) {
+			if (target->isTransparent() != transparent) continue;
+			target->draw(*this);
+		}
+	}
+}
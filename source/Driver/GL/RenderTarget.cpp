@@ -0,0 +1,242 @@
+#include "../../../include/Driver/GL/RenderTarget.hpp"
+
+#include "../../../include/Driver/Platform.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace SuperHaxagon {
+	template<>
+	RenderTarget<Vertex>::RenderTarget(Platform& platform, const bool transparent, const std::string& shaderVertex, const std::string& shaderFragment, std::string label) :
+		_label(std::move(label)),
+		_transparent(transparent) {
+		init(platform, shaderVertex.c_str(), shaderFragment.c_str());
+
+		glEnableVertexAttribArray(0);
+		glEnableVertexAttribArray(1);
+		glEnableVertexAttribArray(2);
+
+		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, x)));
+		glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, c)));
+		glVertexAttribPointer(2, 1, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, z)));
+	}
+
+	template<>
+	RenderTarget<VertexUV>::RenderTarget(Platform& platform, const bool transparent, const std::string& shaderVertex, const std::string& shaderFragment, std::string label) :
+		_label(std::move(label)),
+		_transparent(transparent) {
+		init(platform, shaderVertex.c_str(), shaderFragment.c_str());
+
+		glActiveTexture(GL_TEXTURE0);
+
+		glGenTextures(1, &_tex);
+		glBindTexture(GL_TEXTURE_2D, _tex);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+		glEnableVertexAttribArray(0);
+		glEnableVertexAttribArray(1);
+		glEnableVertexAttribArray(2);
+		glEnableVertexAttribArray(3);
+
+		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(VertexUV), reinterpret_cast<void*>(offsetof(VertexUV, x)));
+		glVertexAttribPointer(1, 2, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(VertexUV), reinterpret_cast<void*>(offsetof(VertexUV, u)));
+		glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(VertexUV), reinterpret_cast<void*>(offsetof(VertexUV, c)));
+		glVertexAttribPointer(3, 1, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(VertexUV), reinterpret_cast<void*>(offsetof(VertexUV, z)));
+	}
+
+	template<class T>
+	RenderTarget<T>::~RenderTarget<T>() {
+		// ignores zeros, so delete away
+		glDeleteBuffers(1, &_vbo.buffer);
+		glDeleteBuffers(1, &_ibo.buffer);
+		glDeleteTextures(1, &_tex);
+		glDeleteProgram(_program);
+	}
+
+	template<class T>
+	void RenderTarget<T>::bind() const {
+		glUseProgram(_program);
+		glBindVertexArray(_vao);
+		glBindBuffer(GL_ARRAY_BUFFER, _vbo.buffer);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ibo.buffer);
+
+		if (_tex) {
+			glActiveTexture(GL_TEXTURE0);
+			glBindTexture(GL_TEXTURE_2D, _tex);
+		}
+	}
+
+	template<class T>
+	void RenderTarget<T>::insert(const T& vertex) {
+		_vertices.push_back(vertex);
+	}
+
+	template<class T>
+	void RenderTarget<T>::reference(const unsigned int index) {
+		if (_transparent) _indices.push_back(_iboLastIndex + index);
+		else _polygon.push_back(_iboLastIndex + index);
+	}
+
+	template<class T>
+	void RenderTarget<T>::advance(const unsigned int indices) {
+		_iboLastIndex += indices;
+		if (_transparent || _polygon.empty()) return;
+
+		if (_first < _polygon.size()) {
+			// Grow towards the front, keeping everything so far at the back
+			const auto used = _indices.size() - _first;
+			const auto size = std::max(_indices.size() * 2, used + _polygon.size());
+			std::vector<unsigned int> grown(size);
+			std::copy(_indices.begin() + _first, _indices.end(), grown.end() - used);
+			_indices = std::move(grown);
+			_first = size - used;
+		}
+
+		_first -= _polygon.size();
+		std::copy(_polygon.begin(), _polygon.end(), _indices.begin() + _first);
+		_polygon.clear();
+	}
+
+	template<class T>
+	void RenderTarget<T>::draw(Platform& platform) {
+		const auto* indices = _indices.data() + _first;
+		const auto count = _indices.size() - _first;
+		if (count) {
+			bind();
+
+			const auto screen = platform.getScreenDim();
+			if (screen.x != _screen.x || screen.y != _screen.y) {
+				glUniform1f(_uniformWidth, static_cast<float>(screen.x));
+				glUniform1f(_uniformHeight, static_cast<float>(screen.y));
+				_screen = screen;
+			}
+
+			const auto vertexOffset = _vbo.upload(platform, _vertices.data(), _vertices.size() * sizeof(T), sizeof(T));
+			const auto indexOffset = _ibo.upload(platform, indices, count * sizeof(unsigned int), sizeof(unsigned int));
+
+			if (_transparent) {
+				glEnable(GL_BLEND);
+				glDepthMask(GL_FALSE);
+				glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+			}
+
+			glDrawElementsBaseVertex(GL_TRIANGLES, count, GL_UNSIGNED_INT, reinterpret_cast<void*>(indexOffset), vertexOffset / sizeof(T));
+			platform.getStats().add(Stat::DRAW_CALLS);
+
+			if (_transparent) {
+				glDepthMask(GL_TRUE);
+				glDisable(GL_BLEND);
+			}
+		}
+
+		_vertices.clear();
+		if (_transparent) _indices.clear();
+		else _first = _indices.size();
+		_iboLastIndex = 0;
+	}
+
+	template<class T>
+	void RenderTarget<T>::init(Platform& platform, const char* shaderVertex, const char* shaderFragment) {
+		_program = linkProgram(platform, shaderVertex, shaderFragment);
+		glUseProgram(_program);
+
+		// glUniform ignores all invalid glGetUniformLocation results, so if the shader doesn't
+		// have these variables then they will be ignored. The sampler never changes.
+		_uniformWidth = glGetUniformLocation(_program, "s_width");
+		_uniformHeight = glGetUniformLocation(_program, "s_height");
+		glUniform1i(glGetUniformLocation(_program, "f_tex"), 0);
+
+		glGenVertexArrays(1, &_vao);
+		glBindVertexArray(_vao);
+
+		glGenBuffers(1, &_vbo.buffer);
+		glBindBuffer(GL_ARRAY_BUFFER, _vbo.buffer);
+		_vbo.label = _label + " vertices";
+
+		glGenBuffers(1, &_ibo.buffer);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ibo.buffer);
+		_ibo.label = _label + " indices";
+	}
+
+	size_t StreamBuffer::upload(Platform& platform, const void* data, const size_t bytes, const size_t align) {
+		if (capacity < bytes * BUFFER_FRAMES) {
+			auto grown = std::max(capacity, BUFFER_MIN_SIZE);
+			while (grown < bytes * BUFFER_FRAMES) grown *= 2;
+			LOG_MESSAGEF(platform, Dbg::INFO, "platform", "resized %s to %zu bytes", label.c_str(), grown);
+			capacity = grown;
+			offset = capacity;
+		}
+
+		auto start = (offset + align - 1) / align * align;
+		if (start + bytes > capacity) {
+			// Orphan, the GPU keeps whatever it is still drawing from
+			glBufferData(type, capacity, nullptr, GL_STREAM_DRAW);
+			start = 0;
+		}
+
+		// Nothing in flight can be reading past offset, so there is no need to wait on the GPU
+		auto* mapped = glMapBufferRange(type, start, bytes, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+		if (mapped) {
+			std::memcpy(mapped, data, bytes);
+			glUnmapBuffer(type);
+		} else {
+			glBufferSubData(type, start, bytes, data);
+		}
+
+		offset = start + bytes;
+		return start;
+	}
+
+	GLuint compileShader(Platform& platform, const GLenum type, const char* source) {
+		GLint success;
+		GLchar msg[512];
+
+		const auto handle = glCreateShader(type);
+		if (!handle) {
+			LOG_MESSAGE(platform, Dbg::INFO, "compile",  "failed to create shader");
+			return 0;
+		}
+
+		glShaderSource(handle, 1, &source, nullptr);
+		glCompileShader(handle);
+		glGetShaderiv(handle, GL_COMPILE_STATUS, &success);
+
+		if (!success) {
+			glGetShaderInfoLog(handle, sizeof(msg), nullptr, msg);
+			LOG_MESSAGE(platform, Dbg::INFO, "compile",  msg);
+			glDeleteShader(handle);
+			return 0;
+		}
+
+		return handle;
+	}
+
+	GLuint linkProgram(Platform& platform, const char* shaderVertex, const char* shaderFragment) {
+		const auto vs = compileShader(platform, GL_VERTEX_SHADER, shaderVertex);
+		const auto fs = compileShader(platform, GL_FRAGMENT_SHADER, shaderFragment);
+
+		const auto program = glCreateProgram();
+		glAttachShader(program, vs);
+		glAttachShader(program, fs);
+		glLinkProgram(program);
+		return program;
+	}
+
+	void uploadTransform(const GLint uniform, const Transform& transform) {
+		// Column major
+		const GLfloat matrix[9]{
+			static_cast<GLfloat>(transform.xx), static_cast<GLfloat>(transform.yx), 0.0f,
+			static_cast<GLfloat>(transform.xy), static_cast<GLfloat>(transform.yy), 0.0f,
+			static_cast<GLfloat>(transform.tx), static_cast<GLfloat>(transform.ty), 1.0f
+		};
+
+		glUniformMatrix3fv(uniform, 1, GL_FALSE, matrix);
+	}
+
+	// Repeat after me: I will only ever instantiate the classes here
+	template class RenderTarget<Vertex>;
+	template class RenderTarget<VertexUV>;
+}
\ No newline at end of file
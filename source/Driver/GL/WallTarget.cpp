@@ -0,0 +1,161 @@
+#include "../../../include/Driver/GL/WallTarget.hpp"
+
+#include "../../../include/Driver/Platform.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+// Corners come from gl_VertexID, drawn as a strip in the same order as
+// Wall::calcStrip: near, far, near, far... Every instance gets as many
+// vertices as the longest run in the batch, shorter runs pile the extras
+// up on their last corner so those triangles have no area.
+static const char* vertex_shader = R"text(
+#version 330 core
+
+layout(location = 0) in float i_distance;
+layout(location = 1) in float i_height;
+layout(location = 2) in float i_side;
+layout(location = 3) in float i_count;
+
+uniform vec2 s_screen;
+uniform vec2 w_focus;
+uniform float w_rotation;
+uniform float w_sides;
+uniform float w_offset;
+uniform float w_scale;
+uniform mat3 w_transform;
+uniform float w_z;
+
+const float PI = 3.14159265358979;
+const float TAU = PI * 2.0;
+const float OVERFLOW = TAU / 1200.0;
+const float HEX_LENGTH = 24.0;
+
+void main() {
+	float far = float(gl_VertexID & 1);
+	float edge = min(float(gl_VertexID >> 1), i_count);
+	float overflow = edge == 0.0 ? -OVERFLOW : (edge == i_count ? OVERFLOW : 0.0);
+
+	float height = i_height;
+	float distance = i_distance + w_offset;
+	if (distance < HEX_LENGTH) {
+		height -= HEX_LENGTH - distance;
+		distance = HEX_LENGTH;
+	}
+
+	float radius = (distance + height * far) * w_scale;
+	float width = min((i_side + edge) * TAU / w_sides + overflow, TAU + OVERFLOW);
+	vec2 point = vec2(radius * cos(w_rotation + width), radius * sin(w_rotation + width + PI)) + w_focus;
+
+	// The platform's transform, then the same projection as every other shader
+	point = (w_transform * vec3(point, 1.0)).xy;
+	float x_norm = (point.x / s_screen.x - 0.5) * 2.0;
+	float y_norm = (point.y / s_screen.y - 0.5) * -2.0;
+
+	gl_Position = vec4(x_norm, y_norm, w_z, 1.0);
+}
+)text";
+
+static const char* fragment_shader = R"text(
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+uniform vec4 w_color;
+
+void main() {
+	color = w_color;
+}
+)text";
+
+namespace SuperHaxagon {
+	static_assert(sizeof(WallInstance) == 8, "walls should stay small, they are uploaded every frame");
+	static_assert(SCALE_HEX_LENGTH == 24.0, "HEX_LENGTH in the wall shader is out of date");
+
+	WallTarget::WallTarget(Platform& platform, const bool transparent) : _transparent(transparent) {
+		_program = linkProgram(platform, vertex_shader, fragment_shader);
+		glUseProgram(_program);
+
+		_uniformScreen = glGetUniformLocation(_program, "s_screen");
+		_uniformFocus = glGetUniformLocation(_program, "w_focus");
+		_uniformRotation = glGetUniformLocation(_program, "w_rotation");
+		_uniformSides = glGetUniformLocation(_program, "w_sides");
+		_uniformOffset = glGetUniformLocation(_program, "w_offset");
+		_uniformScale = glGetUniformLocation(_program, "w_scale");
+		_uniformTransform = glGetUniformLocation(_program, "w_transform");
+		_uniformZ = glGetUniformLocation(_program, "w_z");
+		_uniformColor = glGetUniformLocation(_program, "w_color");
+
+		glGenVertexArrays(1, &_vao);
+		glBindVertexArray(_vao);
+
+		glGenBuffers(1, &_vbo.buffer);
+		glBindBuffer(GL_ARRAY_BUFFER, _vbo.buffer);
+
+		// One set of attributes per run, not per vertex
+		for (GLuint i = 0; i < 4; i++) {
+			glEnableVertexAttribArray(i);
+			glVertexAttribDivisor(i, 1);
+		}
+	}
+
+	WallTarget::~WallTarget() {
+		glDeleteBuffers(1, &_vbo.buffer);
+		glDeleteVertexArrays(1, &_vao);
+		glDeleteProgram(_program);
+	}
+
+	void WallTarget::insert(const Color& color, const WallTransform& transform, const Transform& screen, const uint16_t z, const std::vector<WallInstance>& walls) {
+		uint8_t longest = 1;
+		for (const auto& wall : walls) longest = std::max(longest, wall.count);
+		_batches.push_back({color, transform, screen, z, _walls.size(), walls.size(), longest});
+		_walls.insert(_walls.end(), walls.begin(), walls.end());
+	}
+
+	void WallTarget::draw(Platform& platform) {
+		if (_batches.empty()) return;
+
+		glUseProgram(_program);
+		glBindVertexArray(_vao);
+		glBindBuffer(GL_ARRAY_BUFFER, _vbo.buffer);
+
+		const auto screen = platform.getScreenDim();
+		glUniform2f(_uniformScreen, static_cast<float>(screen.x), static_cast<float>(screen.y));
+
+		const auto offset = _vbo.upload(platform, _walls.data(), _walls.size() * sizeof(WallInstance), sizeof(WallInstance));
+
+		if (_transparent) {
+			glEnable(GL_BLEND);
+			glDepthMask(GL_FALSE);
+			glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		}
+
+		for (const auto& batch : _batches) {
+			const auto& t = batch.transform;
+			const auto first = offset + batch.first * sizeof(WallInstance);
+			glVertexAttribPointer(0, 1, GL_FLOAT, GL_FALSE, sizeof(WallInstance), reinterpret_cast<void*>(first + offsetof(WallInstance, distance)));
+			glVertexAttribPointer(1, 1, GL_UNSIGNED_SHORT, GL_FALSE, sizeof(WallInstance), reinterpret_cast<void*>(first + offsetof(WallInstance, height)));
+			glVertexAttribPointer(2, 1, GL_UNSIGNED_BYTE, GL_FALSE, sizeof(WallInstance), reinterpret_cast<void*>(first + offsetof(WallInstance, side)));
+			glVertexAttribPointer(3, 1, GL_UNSIGNED_BYTE, GL_FALSE, sizeof(WallInstance), reinterpret_cast<void*>(first + offsetof(WallInstance, count)));
+
+			glUniform2f(_uniformFocus, static_cast<float>(t.focus.x), static_cast<float>(t.focus.y));
+			glUniform1f(_uniformRotation, static_cast<float>(std::fmod(t.rotation, TAU)));
+			glUniform1f(_uniformSides, static_cast<float>(t.sides));
+			glUniform1f(_uniformOffset, static_cast<float>(t.offset));
+			glUniform1f(_uniformScale, static_cast<float>(t.scale));
+			uploadTransform(_uniformTransform, batch.screen);
+			glUniform1f(_uniformZ, batch.z / 65535.0f);
+			glUniform4f(_uniformColor, batch.color.r / 255.0f, batch.color.g / 255.0f, batch.color.b / 255.0f, batch.color.a / 255.0f);
+			glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, (batch.longest + 1) * 2, batch.count);
+			platform.getStats().add(Stat::DRAW_CALLS);
+		}
+
+		if (_transparent) {
+			glDepthMask(GL_TRUE);
+			glDisable(GL_BLEND);
+		}
+
+		_batches.clear();
+		_walls.clear();
+	}
+}
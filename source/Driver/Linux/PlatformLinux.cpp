@@ -2,7 +2,6 @@
 
 #include "Core/Twist.hpp"
 
-#include <iostream>
 #include <sys/stat.h>
 
 namespace SuperHaxagon {
@@ -22,15 +21,13 @@ namespace SuperHaxagon {
 	}
 
 	void PlatformLinux::message(Dbg dbg, const std::string& where, const std::string& message) {
-		if (dbg == Dbg::INFO) {
-			std::cout << "[linux:info] " + where + ": " + message << std::endl;
-		} else if (dbg == Dbg::WARN) {
-			std::cout << "[linux:warn] " + where + ": " + message << std::endl;
-		} else if (dbg == Dbg::FATAL) {
-			std::cerr << "[linux:fatal] " + where + ": " + message << std::endl;
-			// Linux users don't need any message boxes like windows because they
-			// spend their entire life in the console anyway.
-		}
+		// Linux users don't need any message boxes like windows because they
+		// spend their entire life in the console anyway.
+		_log.push(dbg, where, message);
+	}
+
+	void PlatformLinux::vmessage(const Dbg dbg, const char* where, const char* format, va_list args) {
+		_log.vpush(dbg, where, format, args);
 	}
 
 	std::unique_ptr<Twist> PlatformLinux::getTwister() {
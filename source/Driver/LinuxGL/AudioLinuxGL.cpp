@@ -0,0 +1,14 @@
+#include "../../../include/Driver/LinuxGL/AudioLinuxGL.hpp"
+
+#include "../../../include/Driver/LinuxGL/PlayerLinuxGL.hpp"
+
+namespace SuperHaxagon {
+	AudioLinuxGL::AudioLinuxGL(PlatformLinuxGL& platform, const Stream stream) : _platform(platform), _stream(stream) {}
+
+	AudioLinuxGL::~AudioLinuxGL() = default;
+
+	std::unique_ptr<Player> AudioLinuxGL::instantiate() {
+		if (_stream != Stream::INDIRECT) return nullptr;
+		return std::make_unique<PlayerLinuxGL>(_platform);
+	}
+}
@@ -0,0 +1,129 @@
+#include "../../../include/Driver/LinuxGL/PlatformLinuxGL.hpp"
+
+#include "../../../include/Core/Twist.hpp"
+#include "../../../include/Driver/LinuxGL/AudioLinuxGL.hpp"
+
+#include <EGL/eglext.h>
+
+#include <cstdlib>
+#include <sys/stat.h>
+
+namespace SuperHaxagon {
+	PlatformLinuxGL::PlatformLinuxGL(const Dbg dbg) : PlatformGL(dbg) {
+		mkdir("./sdmc", 0755);
+
+		const auto* frames = std::getenv("SUPER_HAXAGON_FRAMES");
+		if (frames) _maxFrames = std::strtoull(frames, nullptr, 10);
+		if (std::getenv("SUPER_HAXAGON_CPU_WALLS")) _instancedWalls = false;
+		if (std::getenv("SUPER_HAXAGON_CPU_BACKGROUND")) _shaderBackground = false;
+
+		const auto* fps = std::getenv("SUPER_HAXAGON_FPS");
+		if (fps) _pacer.setRate(std::strtod(fps, nullptr));
+
+		const auto* stats = std::getenv("SUPER_HAXAGON_STATS");
+		if (stats) _stats.setPeriod(std::strtoull(stats, nullptr, 10));
+
+		// Mesa can make a context without any window system at all, anything
+		// else gets the default display and hopefully supports pbuffers.
+		auto display = EGL_NO_DISPLAY;
+		#ifdef EGL_PLATFORM_SURFACELESS_MESA
+		display = eglGetPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+		#endif
+		if (display == EGL_NO_DISPLAY) display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+		if (display == EGL_NO_DISPLAY) {
+			PlatformLinuxGL::message(Dbg::FATAL, "display", "error " + std::to_string(eglGetError()));
+			return;
+		}
+
+		if (!initGL(display, 0, 3, 3)) {
+			PlatformLinuxGL::message(Dbg::FATAL, "egl", "there was a fatal error creating an opengl context");
+			return;
+		}
+
+		_start = std::chrono::steady_clock::now();
+		_loaded = true;
+
+		PlatformLinuxGL::message(Dbg::INFO, "platform", "opengl ok");
+	}
+
+	void PlatformLinuxGL::vmessage(const Dbg dbg, const char* where, const char* format, va_list args) {
+		_log.vpush(dbg, where, format, args);
+	}
+
+	PlatformLinuxGL::~PlatformLinuxGL() = default;
+
+	bool PlatformLinuxGL::loop() {
+		_pacer.wait();
+		return _loaded && (!_maxFrames || _frames < _maxFrames);
+	}
+
+	double PlatformLinuxGL::getDilation() {
+		return 1.0;
+	}
+
+	std::string PlatformLinuxGL::getPath(const std::string& partial) {
+		return std::string("./sdmc") + partial;
+	}
+
+	std::string PlatformLinuxGL::getPathRom(const std::string& partial) {
+		return std::string("./romfs") + partial;
+	}
+
+	std::unique_ptr<Audio> PlatformLinuxGL::loadAudio(const std::string&, const Stream stream) {
+		return std::make_unique<AudioLinuxGL>(*this, stream);
+	}
+
+	void PlatformLinuxGL::playBGM(Audio& audio) {
+		_bgm = audio.instantiate();
+		if (!_bgm) return;
+		_bgm->setLoop(true);
+		_bgm->play();
+	}
+
+	std::string PlatformLinuxGL::getButtonName(const Buttons& button) {
+		if (button.back) return "BACK";
+		if (button.select) return "SELECT";
+		if (button.left) return "LEFT";
+		if (button.right) return "RIGHT";
+		if (button.quit) return "QUIT";
+		return "?";
+	}
+
+	Buttons PlatformLinuxGL::getPressed() {
+		return Buttons{};
+	}
+
+	void PlatformLinuxGL::screenFinalize() {
+		PlatformGL::screenFinalize();
+		_frames++;
+	}
+
+	void PlatformLinuxGL::screenSkip() {
+		// Skipped frames still count, music and SUPER_HAXAGON_FRAMES go by them
+		_frames++;
+		_skipped++;
+	}
+
+	std::unique_ptr<Twist> PlatformLinuxGL::getTwister() {
+		// Always the same seed, so that two runs draw the same frames
+		return std::make_unique<Twist>(
+			std::make_unique<std::seed_seq>(std::initializer_list<int>{0})
+		);
+	}
+
+	void PlatformLinuxGL::shutdown() {
+		if (_frames) {
+			const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - _start;
+			message(Dbg::INFO, "platform", std::to_string(_frames) + " frames, " + std::to_string(_skipped) + " skipped, " + std::to_string(elapsed.count() / _frames) + " ms per frame");
+			if (_pacer.getRate() > 0) message(Dbg::INFO, "platform", std::to_string(_pacer.getMissed()) + " missed deadlines, " + std::to_string(_pacer.getSlop() * 1000.0) + " ms sleep slop");
+			message(Dbg::INFO, "stats", _stats.getSummary());
+		}
+
+		destroyGL();
+	}
+
+	void PlatformLinuxGL::message(const Dbg dbg, const std::string& where, const std::string& message) {
+		_log.push(dbg, where, message);
+	}
+}
@@ -0,0 +1,29 @@
+#include "../../../include/Driver/LinuxGL/PlayerLinuxGL.hpp"
+
+#include "../../../include/Driver/LinuxGL/PlatformLinuxGL.hpp"
+
+namespace SuperHaxagon {
+	PlayerLinuxGL::PlayerLinuxGL(PlatformLinuxGL& platform) : _platform(platform) {}
+
+	PlayerLinuxGL::~PlayerLinuxGL() = default;
+
+	void PlayerLinuxGL::play() {
+		if (_playing) return;
+		_start = _platform.getFrames() - _paused;
+		_playing = true;
+	}
+
+	void PlayerLinuxGL::pause() {
+		if (!_playing) return;
+		_paused = getFrames();
+		_playing = false;
+	}
+
+	double PlayerLinuxGL::getTime() const {
+		return static_cast<double>(getFrames()) / PlatformLinuxGL::FRAME_RATE;
+	}
+
+	uint64_t PlayerLinuxGL::getFrames() const {
+		return _playing ? _platform.getFrames() - _start : _paused;
+	}
+}
@@ -0,0 +1,28 @@
+#include "../../../include/Driver/SDL/AudioSDL.hpp"
+
+#include "../../../include/Driver/Platform.hpp"
+#include "../../../include/Driver/SDL/PlayerMusSDL.hpp"
+#include "../../../include/Driver/SDL/PlayerSfxSDL.hpp"
+
+namespace SuperHaxagon {
+
+	AudioSDL::AudioSDL(Platform& platform, const std::string& path, const Stream stream) {
+		if (stream == Stream::DIRECT) _sfx = Mix_LoadWAV((path + ".wav").c_str());
+		if (stream == Stream::INDIRECT) _music = Mix_LoadMUS((path + ".ogg").c_str());
+
+		if (!_music && stream == Stream::INDIRECT) {
+			platform.message(Dbg::WARN, "music", Mix_GetError());
+		}
+	}
+
+	AudioSDL::~AudioSDL() {
+		if (_sfx) Mix_FreeChunk(_sfx);
+		if (_music) Mix_FreeMusic(_music);
+	}
+
+	std::unique_ptr<Player> AudioSDL::instantiate() {
+		if (_sfx) return std::make_unique<PlayerSfxSDL>(_sfx);
+		if (_music) return std::make_unique<PlayerMusSDL>(_music);
+		return nullptr;
+	}
+}
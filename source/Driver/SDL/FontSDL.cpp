@@ -0,0 +1,76 @@
+#include "../../../include/Driver/SDL/FontSDL.hpp"
+
+#include "../../../include/Driver/SDL/PlatformSDL.hpp"
+
+namespace SuperHaxagon {
+	FontSDL::FontSDL(PlatformSDL& platform, const std::string& path, const double size) :
+		_platform(platform),
+		_atlas(path + ".ttf", size * 2) {
+		if (!_atlas.isLoaded()) {
+			platform.message(Dbg::FATAL, "font", "could not load font " + path + ".ttf");
+			return;
+		}
+
+		// SDL has no single channel textures, so coverage goes into the alpha of white pixels
+		const auto width = _atlas.getTextureWidth();
+		const auto height = _atlas.getTextureHeight();
+		std::vector<uint32_t> pixels(_atlas.getPixels().size());
+		for (size_t i = 0; i < pixels.size(); i++) pixels[i] = 0x00FFFFFFu | static_cast<uint32_t>(_atlas.getPixels()[i]) << 24;
+
+		_texture = SDL_CreateTexture(platform.getRenderer(), SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, width, height);
+		if (!_texture) {
+			platform.message(Dbg::FATAL, "font", SDL_GetError());
+			return;
+		}
+
+		SDL_UpdateTexture(_texture, nullptr, pixels.data(), width * static_cast<int>(sizeof(uint32_t)));
+		SDL_SetTextureBlendMode(_texture, SDL_BLENDMODE_BLEND);
+	}
+
+	FontSDL::~FontSDL() {
+		if (_texture) SDL_DestroyTexture(_texture);
+	}
+
+	double FontSDL::getHeight() const {
+		return _atlas.getAscent();
+	}
+
+	double FontSDL::getWidth(const std::string& text) const {
+		return _atlas.getWidth(text);
+	}
+
+	void FontSDL::draw(const Color& color, const Point& position, Alignment alignment, const std::string& text) {
+		if (!_texture) return;
+		_platform.getStats().add(Stat::TEXT_DRAWS);
+
+		Point cursor = position;
+		const auto width = getWidth(text);
+		if (alignment == Alignment::CENTER) cursor.x = position.x - width / 2;
+		if (alignment == Alignment::RIGHT) cursor.x = position.x - width;
+
+		_quads.clear();
+		_atlas.layout(text, cursor, _quads);
+
+		const SDL_Color sdlColor{color.r, color.g, color.b, color.a};
+		auto base = _platform.startBatch(_texture);
+		auto& vertices = _platform.getVertices();
+		auto& indices = _platform.getIndices();
+		for (const auto& quad : _quads) {
+			const auto x0 = static_cast<float>(quad.position.x);
+			const auto y0 = static_cast<float>(quad.position.y);
+			const auto x1 = static_cast<float>(quad.position.x + quad.size.x);
+			const auto y1 = static_cast<float>(quad.position.y + quad.size.y);
+			const auto u0 = static_cast<float>(quad.uv0.x);
+			const auto v0 = static_cast<float>(quad.uv0.y);
+			const auto u1 = static_cast<float>(quad.uv1.x);
+			const auto v1 = static_cast<float>(quad.uv1.y);
+			vertices.push_back({{x0, y1}, sdlColor, {u0, v1}}); // BL
+			vertices.push_back({{x0, y0}, sdlColor, {u0, v0}}); // TL
+			vertices.push_back({{x1, y0}, sdlColor, {u1, v0}}); // TR
+			vertices.push_back({{x1, y1}, sdlColor, {u1, v1}}); // BR
+
+			indices.insert(indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+			base += 4;
+		}
+	}
+}
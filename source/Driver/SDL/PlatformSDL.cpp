@@ -0,0 +1,314 @@
+#include "../../../include/Driver/SDL/PlatformSDL.hpp"
+
+#include "../../../include/Core/Trace.hpp"
+#include "../../../include/Core/Twist.hpp"
+#include "../../../include/Driver/SDL/AudioSDL.hpp"
+#include "../../../include/Driver/SDL/FontSDL.hpp"
+#include "../../../include/Driver/SDL/PlayerMusSDL.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sys/stat.h>
+
+namespace SuperHaxagon {
+	static SDL_FPoint toPoint(const Point& point) {
+		return {static_cast<float>(point.x), static_cast<float>(point.y)};
+	}
+
+	PlatformSDL::PlatformSDL(const Dbg dbg) : Platform(dbg) {
+		mkdir("./sdmc", 0755);
+
+		const auto* frames = std::getenv("SUPER_HAXAGON_FRAMES");
+		if (frames) _maxFrames = std::strtoull(frames, nullptr, 10);
+
+		const auto* stats = std::getenv("SUPER_HAXAGON_STATS");
+		if (stats) _stats.setPeriod(std::strtoull(stats, nullptr, 10));
+
+		if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) != 0) {
+			PlatformSDL::message(Dbg::FATAL, "sdl", SDL_GetError());
+			return;
+		}
+
+		// The game still runs without sound, the music just won't keep time
+		Mix_Init(MIX_INIT_OGG);
+		if (Mix_OpenAudio(PlayerMusSDL::RATE, MIX_DEFAULT_FORMAT, MIX_DEFAULT_CHANNELS, PlayerMusSDL::BUFFER_FRAMES) != 0) {
+			PlatformSDL::message(Dbg::WARN, "audio", Mix_GetError());
+		}
+
+		Mix_AllocateChannels(16);
+		Mix_SetPostMix(PlayerMusSDL::postMix, nullptr);
+
+		auto width = 1280;
+		auto height = 720;
+		SDL_DisplayMode mode{};
+		if (SDL_GetDesktopDisplayMode(0, &mode) == 0 && mode.w > 0 && mode.h > 0) {
+			width = static_cast<int>(mode.w * 0.75);
+			height = static_cast<int>(mode.h * 0.75);
+		}
+
+		_window = SDL_CreateWindow("Super Haxagon", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, width, height, SDL_WINDOW_RESIZABLE);
+		if (!_window) {
+			PlatformSDL::message(Dbg::FATAL, "window", SDL_GetError());
+			return;
+		}
+
+		SDL_SetWindowMinimumSize(_window, 400, 240);
+
+		const auto* vsync = std::getenv("SUPER_HAXAGON_VSYNC");
+		const auto* fps = std::getenv("SUPER_HAXAGON_FPS");
+		const auto synced = !vsync || std::strcmp(vsync, "0") != 0;
+		_pacer.setRate(fps ? std::strtod(fps, nullptr) : (synced ? 0 : FRAME_RATE));
+
+		// Whatever SDL_RENDER_DRIVER asks for, or the best there is, then software if that didn't work
+		_renderer = SDL_CreateRenderer(_window, -1, synced ? SDL_RENDERER_PRESENTVSYNC : 0);
+		if (!_renderer) _renderer = SDL_CreateRenderer(_window, -1, SDL_RENDERER_SOFTWARE);
+		if (!_renderer) {
+			PlatformSDL::message(Dbg::FATAL, "renderer", SDL_GetError());
+			return;
+		}
+
+		// Untextured geometry is blended with the draw blend mode
+		SDL_SetRenderDrawBlendMode(_renderer, SDL_BLENDMODE_BLEND);
+		SDL_GetRendererInfo(_renderer, &_info);
+
+		_start = std::chrono::steady_clock::now();
+		_last = _start;
+		_loaded = true;
+
+		PlatformSDL::message(Dbg::INFO, "platform", std::string("sdl ok, ") + (_info.name ? _info.name : "?") + " renderer");
+	}
+
+	void PlatformSDL::vmessage(const Dbg dbg, const char* where, const char* format, va_list args) {
+		_log.vpush(dbg, where, format, args);
+	}
+
+	PlatformSDL::~PlatformSDL() {
+		// Music has to stop before the mixer goes away
+		_bgm = nullptr;
+		for (auto* chunk : _sfx) if (chunk) Mix_FreeChunk(chunk);
+		Mix_CloseAudio();
+		Mix_Quit();
+
+		if (_renderer) SDL_DestroyRenderer(_renderer);
+		if (_window) SDL_DestroyWindow(_window);
+		SDL_Quit();
+	}
+
+	bool PlatformSDL::loop() {
+		if (!_loaded) return false;
+
+		// Music only plays once, start it again when it's done
+		if (_bgm && _bgm->isDone()) _bgm->play();
+		_stats.set(Stat::AUDIO_VOICES, Mix_Playing(-1) + (_bgm && !_bgm->isDone() ? 1 : 0));
+
+		_pacer.wait();
+		const auto now = std::chrono::steady_clock::now();
+		_delta = std::chrono::duration<double>(now - _last).count();
+		_last = now;
+
+		SDL_Event event{};
+		while (SDL_PollEvent(&event)) {
+			if (event.type == SDL_QUIT) _loaded = false;
+			if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_F3 && !event.key.repeat) _overlay = !_overlay;
+			#ifdef SUPER_HAXAGON_TRACE
+			if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_F4 && !event.key.repeat) {
+				const auto path = getPath("/trace.json");
+				if (writeTrace(path)) message(Dbg::INFO, "trace", "wrote " + path);
+				else message(Dbg::WARN, "trace", "could not write " + path);
+			}
+			#endif
+		}
+
+		return _loaded && (!_maxFrames || _frames < _maxFrames);
+	}
+
+	double PlatformSDL::getDilation() {
+		// The game was originally designed with 60FPS in mind
+		const auto dilation = _delta / (1.0 / 60.0);
+		return dilation > 4.0 ? 4.0 : (dilation < 0.05 ? 0.05 : dilation);
+	}
+
+	std::string PlatformSDL::getPath(const std::string& partial) {
+		return std::string("./sdmc") + partial;
+	}
+
+	std::string PlatformSDL::getPathRom(const std::string& partial) {
+		return std::string("./romfs") + partial;
+	}
+
+	std::unique_ptr<Audio> PlatformSDL::loadAudio(const std::string& path, const Stream stream) {
+		return std::make_unique<AudioSDL>(*this, path, stream);
+	}
+
+	std::unique_ptr<Font> PlatformSDL::loadFont(const std::string& path, const int size) {
+		return std::make_unique<FontSDL>(*this, path, size);
+	}
+
+	void PlatformSDL::loadSFX() {
+		// SDL_mixer can't convert chunks that it doesn't own, so have
+		// the sound bank decode straight into the output format.
+		auto rate = PlayerMusSDL::RATE;
+		Uint16 format = 0;
+		auto channels = MIX_DEFAULT_CHANNELS;
+		if (!Mix_QuerySpec(&rate, &format, &channels) || format != AUDIO_S16SYS) {
+			// The bank only decodes to 16 bit, silence is better than playing it as noise
+			Platform::loadSFX();
+			return;
+		}
+
+		_sounds = std::make_unique<SoundBank>(*this, rate, channels);
+
+		for (auto i = 0; i < static_cast<int>(SoundId::LAST); i++) {
+			const auto& sound = _sounds->get(static_cast<SoundId>(i));
+			if (!sound.samples) continue;
+			auto* data = reinterpret_cast<Uint8*>(const_cast<int16_t*>(sound.samples));
+			_sfx[i] = Mix_QuickLoad_RAW(data, sound.frames * sound.channels * sizeof(int16_t));
+		}
+	}
+
+	void PlatformSDL::playSFX(const SoundId id) {
+		auto* chunk = _sfx[static_cast<size_t>(id)];
+		if (!chunk) return;
+		Mix_PlayChannel(-1, chunk, 0);
+	}
+
+	void PlatformSDL::playBGM(Audio& audio) {
+		_bgm = audio.instantiate();
+		if (!_bgm) return;
+		_bgm->setLoop(true);
+		_bgm->play();
+	}
+
+	std::string PlatformSDL::getButtonName(const Buttons& button) {
+		if (button.back) return "ESC";
+		if (button.select) return "ENTER";
+		if (button.left) return "LEFT";
+		if (button.right) return "RIGHT";
+		if (button.quit) return "DELETE";
+		return "?";
+	}
+
+	Buttons PlatformSDL::getPressed() {
+		// SDL clears the keyboard state when the window loses focus
+		const auto* keys = SDL_GetKeyboardState(nullptr);
+		Buttons buttons{};
+		buttons.select = keys[SDL_SCANCODE_RETURN];
+		buttons.back = keys[SDL_SCANCODE_ESCAPE];
+		buttons.quit = keys[SDL_SCANCODE_DELETE];
+		buttons.left = keys[SDL_SCANCODE_LEFT] || keys[SDL_SCANCODE_A];
+		buttons.right = keys[SDL_SCANCODE_RIGHT] || keys[SDL_SCANCODE_D];
+		return buttons;
+	}
+
+	Point PlatformSDL::getScreenDim() const {
+		auto width = 0;
+		auto height = 0;
+		if (_renderer) SDL_GetRendererOutputSize(_renderer, &width, &height);
+		return {static_cast<double>(width), static_cast<double>(height)};
+	}
+
+	void PlatformSDL::screenBegin() {
+		SDL_SetRenderDrawColor(_renderer, 0, 0, 0, 0xFF);
+		SDL_RenderClear(_renderer);
+	}
+
+	void PlatformSDL::screenSwap() {
+		// Nothing to do, there is only one screen
+	}
+
+	void PlatformSDL::screenFinalize() {
+		{
+			TRACE_ZONE("PlatformSDL::batches");
+			const auto vertices = static_cast<int>(_vertices.size());
+			for (size_t i = 0; i < _runs.size(); i++) {
+				const auto start = _runs[i].start;
+				const auto end = i + 1 < _runs.size() ? _runs[i + 1].start : _indices.size();
+				if (end == start) continue;
+				SDL_RenderGeometry(_renderer, _runs[i].texture, _vertices.data(), vertices, &_indices[start], static_cast<int>(end - start));
+				_stats.add(Stat::DRAW_CALLS);
+			}
+
+			_drawn = _runs.size();
+			_vertices.clear();
+			_indices.clear();
+			_runs.clear();
+		}
+
+		TRACE_ZONE("PlatformSDL::present");
+		SDL_RenderPresent(_renderer);
+		_frames++;
+	}
+
+	void PlatformSDL::screenSkip() {
+		// Without a present there is no vsync to wait on
+		if (_pacer.getRate() <= 0) _idle.wait();
+
+		// Still a frame, or an idle menu would never reach SUPER_HAXAGON_FRAMES
+		_frames++;
+	}
+
+	void PlatformSDL::drawPoly(const Color& color, const std::vector<Point>& points) {
+		if (points.size() < 3) return;
+		_stats.addPoly(points.size());
+
+		const SDL_Color sdlColor{color.r, color.g, color.b, color.a};
+		const auto& transform = getTransform();
+		const auto base = startBatch(nullptr);
+		for (const auto& point : points) _vertices.push_back({toPoint(transformPoint(transform, point)), sdlColor, {0, 0}});
+		for (auto i = 1; i + 1 < static_cast<int>(points.size()); i++) _indices.insert(_indices.end(), {base, base + i, base + i + 1});
+	}
+
+	bool PlatformSDL::drawStrip(const Color& color, const std::vector<Point>& points) {
+		_stats.addPoly(points.size());
+		const SDL_Color sdlColor{color.r, color.g, color.b, color.a};
+		const auto& transform = getTransform();
+		const auto base = startBatch(nullptr);
+		for (const auto& point : points) _vertices.push_back({toPoint(transformPoint(transform, point)), sdlColor, {0, 0}});
+		for (auto i = 2; i < static_cast<int>(points.size()); i++) _indices.insert(_indices.end(), {base + i - 2, base + i - 1, base + i});
+		return true;
+	}
+
+	int PlatformSDL::startBatch(SDL_Texture* texture) {
+		if (_runs.empty() || _runs.back().texture != texture) _runs.push_back({texture, _indices.size()});
+		return static_cast<int>(_vertices.size());
+	}
+
+	void PlatformSDL::getDebugInfo(std::vector<std::string>& lines) {
+		if (!_overlay) return;
+
+		std::string name = _info.name ? _info.name : "?";
+		std::transform(name.begin(), name.end(), name.begin(), [](const unsigned char c) {return static_cast<char>(std::toupper(c));});
+		lines.emplace_back("RENDER " + name);
+
+		char line[64];
+		std::snprintf(line, sizeof(line), "BATCH %zu RUNS", _drawn);
+		lines.emplace_back(line);
+
+		if (_pacer.getRate() > 0) {
+			std::snprintf(line, sizeof(line), "PACE %.0f FPS %llu MISSED", _pacer.getRate(), static_cast<unsigned long long>(_pacer.getMissed()));
+			lines.emplace_back(line);
+		}
+	}
+
+	std::unique_ptr<Twist> PlatformSDL::getTwister() {
+		std::random_device source;
+		std::mt19937::result_type data[std::mt19937::state_size];
+		generate(std::begin(data), std::end(data), ref(source));
+		return std::make_unique<Twist>(
+			std::make_unique<std::seed_seq>(std::begin(data), std::end(data))
+		);
+	}
+
+	void PlatformSDL::shutdown() {
+		if (!_frames) return;
+		const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - _start;
+		message(Dbg::INFO, "platform", std::to_string(_frames) + " frames, " + std::to_string(elapsed.count() / _frames) + " ms per frame");
+	}
+
+	void PlatformSDL::message(const Dbg dbg, const std::string& where, const std::string& message) {
+		_log.push(dbg, where, message);
+	}
+}
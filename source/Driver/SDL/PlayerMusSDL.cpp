@@ -0,0 +1,78 @@
+#include "../../../include/Driver/SDL/PlayerMusSDL.hpp"
+
+namespace SuperHaxagon {
+	std::atomic<uint64_t> PlayerMusSDL::_consumed{0};
+
+	PlayerMusSDL::PlayerMusSDL(Mix_Music* music) : _music(music) {}
+
+	PlayerMusSDL::~PlayerMusSDL() {
+		Mix_HaltMusic();
+	}
+
+	void PlayerMusSDL::postMix(void*, Uint8*, const int length) {
+		// Runs on the audio thread, right before the buffer is handed to the device
+		if (!Mix_PlayingMusic() || Mix_PausedMusic()) return;
+
+		auto rate = 0;
+		Uint16 format = 0;
+		auto channels = 0;
+		if (!Mix_QuerySpec(&rate, &format, &channels)) return;
+
+		const auto frameBytes = channels * SDL_AUDIO_BITSIZE(format) / 8;
+		if (frameBytes > 0) _consumed += length / frameBytes;
+	}
+
+	void PlayerMusSDL::setLoop(const bool loop) {
+		_loop = loop;
+	}
+
+	void PlayerMusSDL::play() {
+		_playing = true;
+
+		if (isDone()) {
+			// Music is only played once and the platform restarts it, that way it's known
+			// when the music is over and the timers can be reset. The platform calls play
+			// every frame it's done, so if nothing is playing restart the music.
+			_consumed = 0;
+			_clock.reset();
+			Mix_PlayMusic(_music, 1);
+			return;
+		}
+
+		// We are not done, so resume the currently playing music.
+		Mix_ResumeMusic();
+	}
+
+	void PlayerMusSDL::pause() {
+		_playing = false;
+		Mix_PauseMusic();
+	}
+
+	bool PlayerMusSDL::isDone() const {
+		// Note that Mix_PlayingMusic does not check if the channel is paused.
+		return !Mix_PlayingMusic();
+	}
+
+	double PlayerMusSDL::getTime() const {
+		// Frozen in time while paused
+		if (!_playing) return _clock.get();
+
+		auto rate = RATE;
+		Uint16 format = 0;
+		auto channels = 0;
+		Mix_QuerySpec(&rate, &format, &channels);
+
+		// The device takes a whole buffer at a time, which is also how long it takes to hear it
+		const auto position = static_cast<double>(_consumed.load()) / rate - getLatency();
+		return _clock.update(position, getNow(), getLatency());
+	}
+
+	double PlayerMusSDL::getLatency() const {
+		return static_cast<double>(BUFFER_FRAMES) / RATE;
+	}
+
+	double PlayerMusSDL::getNow() const {
+		// Only used to smooth things out between buffers
+		return static_cast<double>(SDL_GetPerformanceCounter()) / SDL_GetPerformanceFrequency();
+	}
+}
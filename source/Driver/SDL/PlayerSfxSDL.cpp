@@ -0,0 +1,11 @@
+#include "../../../include/Driver/SDL/PlayerSfxSDL.hpp"
+
+namespace SuperHaxagon {
+	PlayerSfxSDL::PlayerSfxSDL(Mix_Chunk* sfx) : _sfx(sfx) {}
+	
+	PlayerSfxSDL::~PlayerSfxSDL() = default;
+
+	void PlayerSfxSDL::play() {
+		Mix_PlayChannel(-1, _sfx, 0);
+	}
+}
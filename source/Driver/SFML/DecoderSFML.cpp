@@ -0,0 +1,19 @@
+#include "../../../include/Driver/SFML/DecoderSFML.hpp"
+
+namespace SuperHaxagon {
+	bool DecoderSFML::open(const std::string& path) {
+		if (!_file.openFromFile(path)) return false;
+		_channels = _file.getChannelCount();
+		_rate = _file.getSampleRate();
+		return _channels > 0 && _rate > 0;
+	}
+
+	size_t DecoderSFML::read(int16_t* out, const size_t frames) {
+		if (!_channels) return 0;
+		return static_cast<size_t>(_file.read(out, frames * _channels)) / _channels;
+	}
+
+	void DecoderSFML::rewind() {
+		_file.seek(static_cast<sf::Uint64>(0));
+	}
+}
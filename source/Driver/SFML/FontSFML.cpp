@@ -26,31 +26,77 @@ namespace SuperHaxagon {
 
 	double FontSFML::getWidth(const std::string& text) const {
 		if (!_loaded) return 0;
-		sf::Text sfText;
-		sfText.setFont(_font);
-		sfText.setCharacterSize(static_cast<int>(_size * _scale));
-		sfText.setString(text);
-		return sfText.getLocalBounds().width;
+		const auto size = getCharacterSize();
+		auto& glyphs = getGlyphs(size);
+		float width = 0;
+		for (const auto c : text) width += getGlyph(glyphs, size, c).advance;
+		return width;
 	}
 
 	void FontSFML::draw(const Color& color, const Point& position, const Alignment alignment, const std::string& text) {
 		if (!_loaded) return;
-		sf::Text sfText;
-		sf::Vector2f sfPosition;
-		sfPosition.y = static_cast<float>(position.y);
-		sfText.setFont(_font);
-		sfText.setCharacterSize(static_cast<int>(_size * _scale));
-		sfText.setFillColor({color.r, color.g, color.b, color.a});
-		sfText.setString(text);
-
-		const auto width = sfText.getLocalBounds().width;
-		if (alignment == Alignment::LEFT) sfPosition.x = static_cast<float>(position.x);
-		if (alignment == Alignment::CENTER) sfPosition.x = static_cast<float>(position.x - width / 2);
-		if (alignment == Alignment::RIGHT) sfPosition.x = static_cast<float>(position.x - width);
-		sfPosition.x = std::round(sfPosition.x);
-		sfPosition.y = std::round(sfPosition.y);
-		sfText.setPosition(sfPosition);
-
-		_platform.getWindow().draw(sfText);
+		_platform.getStats().add(Stat::TEXT_DRAWS);
+
+		// Measuring first also makes sure every glyph is in the texture before it's used
+		const auto size = getCharacterSize();
+		auto& glyphs = getGlyphs(size);
+		const auto width = getWidth(text);
+
+		auto x = position.x;
+		if (alignment == Alignment::CENTER) x -= width / 2;
+		if (alignment == Alignment::RIGHT) x -= width;
+
+		// Same layout as sf::Text, which puts the baseline one character size down
+		auto pen = static_cast<float>(std::round(x));
+		const auto baseline = static_cast<float>(std::round(position.y)) + static_cast<float>(size);
+		const sf::Color sfColor{color.r, color.g, color.b, color.a};
+
+		auto& batch = _platform.getBatch(&_font.getTexture(size));
+		for (const auto c : text) {
+			const auto& glyph = getGlyph(glyphs, size, c);
+			if (glyph.rect.width > 0 && glyph.rect.height > 0) {
+				const auto left = pen + glyph.bounds.left;
+				const auto top = baseline + glyph.bounds.top;
+				const auto right = left + glyph.bounds.width;
+				const auto bottom = top + glyph.bounds.height;
+
+				const auto u1 = static_cast<float>(glyph.rect.left);
+				const auto v1 = static_cast<float>(glyph.rect.top);
+				const auto u2 = static_cast<float>(glyph.rect.left + glyph.rect.width);
+				const auto v2 = static_cast<float>(glyph.rect.top + glyph.rect.height);
+
+				batch.emplace_back(sf::Vector2f(left, top), sfColor, sf::Vector2f(u1, v1));
+				batch.emplace_back(sf::Vector2f(right, top), sfColor, sf::Vector2f(u2, v1));
+				batch.emplace_back(sf::Vector2f(left, bottom), sfColor, sf::Vector2f(u1, v2));
+				batch.emplace_back(sf::Vector2f(left, bottom), sfColor, sf::Vector2f(u1, v2));
+				batch.emplace_back(sf::Vector2f(right, top), sfColor, sf::Vector2f(u2, v1));
+				batch.emplace_back(sf::Vector2f(right, bottom), sfColor, sf::Vector2f(u2, v2));
+			}
+
+			pen += glyph.advance;
+		}
+	}
+
+	unsigned int FontSFML::getCharacterSize() const {
+		return static_cast<unsigned int>(_size * _scale);
+	}
+
+	const FontSFML::Glyph& FontSFML::getGlyph(Glyphs& glyphs, const unsigned int size, const char c) const {
+		auto& glyph = glyphs[static_cast<unsigned char>(c)];
+		if (glyph.loaded) return glyph;
+
+		// Only the first use of a character at a size goes through SFML
+		const auto& sfGlyph = _font.getGlyph(static_cast<unsigned char>(c), size, false);
+		glyph.advance = sfGlyph.advance;
+		glyph.bounds = sfGlyph.bounds;
+		glyph.rect = sfGlyph.textureRect;
+		glyph.loaded = true;
+		return glyph;
+	}
+
+	FontSFML::Glyphs& FontSFML::getGlyphs(const unsigned int size) const {
+		auto& glyphs = _glyphs[size];
+		if (!glyphs) glyphs = std::make_unique<Glyphs>();
+		return *glyphs;
 	}
 }
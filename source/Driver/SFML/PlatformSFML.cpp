@@ -1,37 +1,125 @@
 #include "../../../include/Driver/SFML/PlatformSFML.hpp"
 
+#include "../../../include/Core/InputSampler.hpp"
+#include "../../../include/Core/Mixer.hpp"
 #include "../../../include/Core/Structs.hpp"
+#include "../../../include/Core/Trace.hpp"
 #include "../../../include/Driver/SFML/AudioSFML.hpp"
 #include "../../../include/Driver/SFML/FontSFML.hpp"
-#include "../../../include/Driver/SFML/PlayerSoundSFML.hpp"
+#include "../../../include/Driver/SFML/SinkSFML.hpp"
 
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <string>
 
 namespace SuperHaxagon {
-	PlatformSFML::PlatformSFML(const Dbg dbg, sf::VideoMode video) : Platform(dbg) {
+	struct QualityLevel {
+		double scale;
+		unsigned int antialiasing;
+	};
+
+	// Antialiasing is given up before resolution, it is the more expensive of the two
+	static constexpr std::array<QualityLevel, 7> QUALITY_LEVELS{{
+		{1.0, 8},
+		{1.0, 4},
+		{1.0, 2},
+		{1.0, 0},
+		{0.75, 0},
+		{0.6, 0},
+		{0.5, 0},
+	}};
+
+	// Frames the display's refresh is measured over when vsync paces the loop
+	static constexpr int REFRESH_FRAMES = 60;
+
+	static sf::Vector2f toVector(const Point& point) {
+		return {static_cast<float>(point.x), static_cast<float>(point.y)};
+	}
+
+	PlatformSFML::PlatformSFML(const Dbg dbg, sf::VideoMode video) : Platform(dbg), _quality(1.0 / FRAME_RATE, QUALITY_LEVELS.size()) {
 		_clock.restart();
 
-		sf::ContextSettings settings;
-		settings.antialiasingLevel = 8;
+		// The window itself has no antialiasing, that's up to the texture everything is drawn to
+		_window = std::make_unique<sf::RenderWindow>(video, "Super Haxagon", sf::Style::Default);
+
+		const auto* vsync = std::getenv("SUPER_HAXAGON_VSYNC");
+		const auto* fps = std::getenv("SUPER_HAXAGON_FPS");
+		_synced = !vsync || std::strcmp(vsync, "0") != 0;
+		_window->setVerticalSyncEnabled(_synced);
+		_pacer.setRate(fps ? std::strtod(fps, nullptr) : (_synced ? 0 : FRAME_RATE));
+		if (_pacer.getRate() > 0) _quality.setTarget(1.0 / _pacer.getRate());
+
+		const auto* stats = std::getenv("SUPER_HAXAGON_STATS");
+		if (stats) _stats.setPeriod(std::strtoull(stats, nullptr, 10));
+
+		// All audio goes through one software mixer running on its own thread
+		_mixer = std::make_unique<Mixer>();
+		_sink = std::make_unique<SinkSFML>();
+		_sink->play();
+		_audible = _sink->getStatus() == sf::SoundStream::Playing;
+		if (_audible) _mixer->start(*_sink);
+
+		// sf::Keyboard can't be read off the main thread and SFML events carry no
+		// time, so key events are stamped as they're polled, once a frame. A tap
+		// still counts, but holds are only as fine as the frame rate.
+		_input = std::make_unique<InputSampler>();
 
-		_window = std::make_unique<sf::RenderWindow>(video, "Super Haxagon", sf::Style::Default, settings);
-		_window->setVerticalSyncEnabled(true);
 		_loaded = true;
 	}
 
-	PlatformSFML::~PlatformSFML() = default;
+	PlatformSFML::~PlatformSFML() {
+		// The BGM player talks to the mixer when it is destroyed
+		_bgm = nullptr;
+		_mixer->stop();
+		_sink->stop();
+	}
 
 	bool PlatformSFML::loop() {
-		const auto throttle = sf::milliseconds(1);
-		sf::sleep(throttle);
+		// Housekeeping goes before the wait, so that events and input are read
+		// as late as possible and are as fresh as they can be when the frame is built
+		_mixer->collect();
+		_stats.set(Stat::AUDIO_VOICES, _mixer->getPlaying());
+		const auto dropped = _mixer->takeDropped();
+		if (dropped) LOG_MESSAGEF(*this, Dbg::WARN, "mixer", "%u commands dropped, the queue was full", dropped);
+
+		// The frame's work is everything since the last wait, less any idling in screenSkip.
+		// With vsync that still has the wait in display, so on time is one refresh.
+		auto changed = _quality.update(_clock.getElapsedTime().asSeconds() - _idled);
+
+		_pacer.wait();
 		_delta = _clock.getElapsedTime().asSeconds();
 		_clock.restart();
+		_idled = 0.0;
+		if (_pacer.getRate() <= 0 && _synced) measureRefresh();
+
 		sf::Event event{};
 		while (_window->pollEvent(event)) {
 			if (event.type == sf::Event::Closed) _window->close();
 			if (event.type == sf::Event::GainedFocus) _focus = true;
-			if (event.type == sf::Event::LostFocus) _focus = false;
+			if (event.type == sf::Event::LostFocus) {
+				// Keys let go of elsewhere never send a release
+				_focus = false;
+				_keys.fill(false);
+				_input->record(getKeys());
+			}
+
+			if ((event.type == sf::Event::KeyPressed || event.type == sf::Event::KeyReleased) && event.key.code >= 0 && event.key.code < sf::Keyboard::KeyCount) {
+				_keys[event.key.code] = event.type == sf::Event::KeyPressed;
+				_input->record(getKeys());
+			}
+
+			if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F3) _overlay = !_overlay;
+			#ifdef SUPER_HAXAGON_TRACE
+			if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F4) {
+				const auto path = getPath("/trace.json");
+				if (writeTrace(path)) message(Dbg::INFO, "trace", "wrote " + path);
+				else message(Dbg::WARN, "trace", "could not write " + path);
+			}
+			#endif
 			if (event.type == sf::Event::Resized) {
 				const auto width = event.size.width > 400 ? event.size.width : 400;
 				const auto height = event.size.height > 240 ? event.size.height : 240;
@@ -48,8 +136,11 @@ namespace SuperHaxagon {
 				);
 
 				_window->setView(sf::View(visibleArea));
+				changed = true;
 			}
 		}
+
+		if (changed || !_applied) applyQuality();
 		return _loaded && _window->isOpen();
 	}
 
@@ -60,31 +151,41 @@ namespace SuperHaxagon {
 	}
 
 	std::unique_ptr<Audio> PlatformSFML::loadAudio(const std::string& path, Stream stream) {
-		return std::make_unique<AudioSFML>(path, stream);
+		return std::make_unique<AudioSFML>(*_mixer, path, stream);
 	}
 
 	std::unique_ptr<Font> PlatformSFML::loadFont(const std::string& path, int size) {
 		return std::make_unique<FontSFML>(*this, path, size);
 	}
 
-	void PlatformSFML::playSFX(Audio& audio) {
-		for (auto it = _sfx.begin(); it != _sfx.end();) {
-			auto& playing = *it;
-			if (playing->isDone()) {
-				it = _sfx.erase(it);
-			} else {
-				++it;
-			}
+	void PlatformSFML::loadSFX() {
+		// Said here, messages can't be sent until the driver is fully made
+		if (!_audible) message(Dbg::WARN, "audio", "could not start the audio stream, playing without sound");
+		Platform::loadSFX();
+
+		// The mixer plays straight out of the sound bank
+		for (auto i = 0; i < static_cast<int>(SoundId::LAST); i++) {
+			const auto& sound = _sounds->get(static_cast<SoundId>(i));
+			if (!sound.samples) continue;
+			auto pcm = std::make_shared<Pcm>();
+			pcm->samples = sound.samples;
+			pcm->frames = sound.frames;
+			pcm->channels = sound.channels;
+			pcm->rate = sound.rate;
+			_sfx[i] = std::move(pcm);
 		}
+	}
 
-		auto player = audio.instantiate();
-		if (!player) return;
-		player->setLoop(false);
-		player->play();
-		_sfx.emplace_back(std::move(player));
+	void PlatformSFML::playSFX(const SoundId id) {
+		// Sound effects go straight to the mixer instead of instantiating a new player each time.
+		const auto& pcm = _sfx[static_cast<size_t>(id)];
+		if (!pcm || !_audible) return;
+		_mixer->playSFX(pcm, Mixer::DEFAULT_POLYPHONY);
 	}
 
 	void PlatformSFML::playBGM(Audio& audio) {
+		// Nothing would take the mixer's commands, and the BGM clock would never move
+		if (!_audible) return;
 		_bgm = audio.instantiate();
 		if (!_bgm) return;
 		_bgm->setLoop(true);
@@ -101,13 +202,26 @@ namespace SuperHaxagon {
 	}
 
 	Buttons PlatformSFML::getPressed() {
+		return getKeys();
+	}
+
+	bool PlatformSFML::pollInput(std::vector<InputEvent>& events) {
+		_input->poll(events);
+		return true;
+	}
+
+	double PlatformSFML::getInputTime() const {
+		return _input->getTime();
+	}
+
+	Buttons PlatformSFML::getKeys() const {
 		Buttons buttons{};
 		if (!_focus) return buttons;
-		buttons.select = sf::Keyboard::isKeyPressed(sf::Keyboard::Enter);
-		buttons.back = sf::Keyboard::isKeyPressed(sf::Keyboard::Escape);
-		buttons.quit = sf::Keyboard::isKeyPressed(sf::Keyboard::Delete);
-		buttons.left = sf::Keyboard::isKeyPressed(sf::Keyboard::Left) | sf::Keyboard::isKeyPressed(sf::Keyboard::A);
-		buttons.right = sf::Keyboard::isKeyPressed(sf::Keyboard::Right) | sf::Keyboard::isKeyPressed(sf::Keyboard::D);
+		buttons.select = _keys[sf::Keyboard::Enter];
+		buttons.back = _keys[sf::Keyboard::Escape];
+		buttons.quit = _keys[sf::Keyboard::Delete];
+		buttons.left = _keys[sf::Keyboard::Left] || _keys[sf::Keyboard::A];
+		buttons.right = _keys[sf::Keyboard::Right] || _keys[sf::Keyboard::D];
 		return buttons;
 	}
 
@@ -119,7 +233,8 @@ namespace SuperHaxagon {
 	}
 
 	void PlatformSFML::screenBegin() {
-		_window->clear(sf::Color::Black);
+		if (_texture) _texture->clear(sf::Color::Black);
+		else _window->clear(sf::Color::Black);
 	}
 
 	void PlatformSFML::screenSwap() {
@@ -127,19 +242,149 @@ namespace SuperHaxagon {
 	}
 
 	void PlatformSFML::screenFinalize() {
+		{
+			TRACE_ZONE("PlatformSFML::batches");
+			sf::RenderTarget& target = _texture ? static_cast<sf::RenderTarget&>(*_texture) : *_window;
+			for (size_t i = 0; i < _runs.size(); i++) {
+				const auto start = _runs[i].start;
+				const auto end = i + 1 < _runs.size() ? _runs[i + 1].start : _batch.size();
+				if (end == start) continue;
+				target.draw(&_batch[start], end - start, sf::Triangles, sf::RenderStates(_runs[i].texture));
+				_stats.add(Stat::DRAW_CALLS);
+			}
+
+			_batch.clear();
+			_runs.clear();
+		}
+
+		TRACE_ZONE("PlatformSFML::present");
+		if (_texture) {
+			_texture->display();
+			const auto size = _window->getSize();
+			const auto textureSize = _texture->getSize();
+			sf::Sprite sprite(_texture->getTexture());
+			sprite.setScale(static_cast<float>(size.x) / textureSize.x, static_cast<float>(size.y) / textureSize.y);
+			_window->draw(sprite);
+		}
+
 		_window->display();
 	}
 
+	void PlatformSFML::screenSkip() {
+		// Without a present there is no vsync to wait on
+		if (_pacer.getRate() > 0) return;
+		const auto start = _clock.getElapsedTime().asSeconds();
+		_idle.wait();
+		_idled += _clock.getElapsedTime().asSeconds() - start;
+	}
+
 	void PlatformSFML::drawPoly(const Color& color, const std::vector<Point>& points) {
+		if (points.size() < 3) return;
+		_stats.addPoly(points.size());
+
+		// Every page of an sf::Font has a white square in the top left corner,
+		// so pointing at it makes a polygon look the same with or without a font texture.
+		const sf::Color sfColor{ color.r, color.g, color.b, color.a };
+		const sf::Vector2f white{1, 1};
+		const auto& transform = getTransform();
+		const auto first = toVector(transformPoint(transform, points[0]));
+
+		auto& batch = getBatch(nullptr);
+		for (size_t i = 1; i + 1 < points.size(); i++) {
+			batch.emplace_back(first, sfColor, white);
+			batch.emplace_back(toVector(transformPoint(transform, points[i])), sfColor, white);
+			batch.emplace_back(toVector(transformPoint(transform, points[i + 1])), sfColor, white);
+		}
+	}
+
+	bool PlatformSFML::drawStrip(const Color& color, const std::vector<Point>& points) {
+		_stats.addPoly(points.size());
 		const sf::Color sfColor{ color.r, color.g, color.b, color.a };
-		sf::ConvexShape convex(points.size());
-		convex.setPosition(0, 0);
-		convex.setFillColor(sfColor);
-		auto index = 0;
-		for (const auto& point : points) {
-			convex.setPoint(index++, sf::Vector2f(static_cast<float>(point.x), static_cast<float>(point.y)));
+		const sf::Vector2f white{1, 1};
+
+		// The batch is plain triangles, so every point is used by up to three of them
+		const auto& transform = getTransform();
+		auto& batch = getBatch(nullptr);
+		for (size_t i = 2; i < points.size(); i++) {
+			for (auto j = i - 2; j <= i; j++) {
+				batch.emplace_back(toVector(transformPoint(transform, points[j])), sfColor, white);
+			}
+		}
+
+		return true;
+	}
+
+	void PlatformSFML::getDebugInfo(std::vector<std::string>& lines) {
+		if (!_overlay) return;
+
+		char line[64];
+		const auto level = _quality.getLevel();
+		std::snprintf(line, sizeof(line), "QUALITY %zu/%zu", level + 1, _quality.getLevels());
+		lines.emplace_back(line);
+
+		if (_texture) {
+			const auto size = _texture->getSize();
+			std::snprintf(line, sizeof(line), "RENDER %ux%u %uX AA", size.x, size.y, _antialiasing);
+		} else {
+			std::snprintf(line, sizeof(line), "RENDER WINDOW");
 		}
+		lines.emplace_back(line);
+
+		std::snprintf(line, sizeof(line), "FRAME %.1fMS / %.1fMS", _quality.getAverage() * 1000.0, _quality.getTarget() * 1000.0);
+		lines.emplace_back(line);
+
+		if (_pacer.getRate() > 0) {
+			std::snprintf(line, sizeof(line), "PACE %.0fHZ %zu MISSED %.2fMS SLOP", _pacer.getRate(), _pacer.getMissed(), _pacer.getSlop() * 1000.0);
+			lines.emplace_back(line);
+		}
+	}
+
+	std::vector<sf::Vertex>& PlatformSFML::getBatch(const sf::Texture* texture) {
+		if (_runs.empty()) {
+			_runs.push_back({texture, _batch.size()});
+		} else if (texture && texture != _runs.back().texture) {
+			// A run of only polygons can take on the texture
+			if (_runs.back().texture) _runs.push_back({texture, _batch.size()});
+			else _runs.back().texture = texture;
+		}
+
+		return _batch;
+	}
+
+	void PlatformSFML::measureRefresh() {
+		// SFML can't say what the display refreshes at, but a frame that made it
+		// in time takes exactly one refresh, and slower ones take whole multiples
+		_shortest = std::min(_shortest, _delta);
+		if (++_refreshFrames < REFRESH_FRAMES) return;
+
+		// Aims no lower than FRAME_RATE, in case no frame made it in time at all
+		_quality.setTarget(std::min(_shortest, 1.0 / FRAME_RATE));
+		_shortest = 1.0 / FRAME_RATE;
+		_refreshFrames = 0;
+	}
+
+	void PlatformSFML::applyQuality() {
+		_applied = true;
+		const auto& quality = QUALITY_LEVELS[_quality.getLevel()];
+		const auto size = _window->getSize();
+		const auto width = std::max(1u, static_cast<unsigned int>(std::lround(size.x * quality.scale)));
+		const auto height = std::max(1u, static_cast<unsigned int>(std::lround(size.y * quality.scale)));
+
+		sf::ContextSettings settings;
+		settings.antialiasingLevel = std::min(quality.antialiasing, sf::RenderTexture::getMaximumAntialiasingLevel());
+
+		if (!_texture) _texture = std::make_unique<sf::RenderTexture>();
+		if (!_texture->create(width, height, settings)) {
+			// Drawing straight to the window still works, just without any of this
+			message(Dbg::WARN, "quality", "cannot create a " + std::to_string(width) + "x" + std::to_string(height) + " render texture");
+			_texture = nullptr;
+			return;
+		}
+
+		_antialiasing = settings.antialiasingLevel;
+		_texture->setSmooth(true);
 
-		_window->draw(convex);
+		// The game keeps drawing in window coordinates
+		_texture->setView(sf::View(sf::FloatRect(0.0f, 0.0f, static_cast<float>(size.x), static_cast<float>(size.y))));
 	}
 }
@@ -1,29 +1,43 @@
 #include "../../../include/Driver/SFML/PlayerMusicSFML.hpp"
 
+#include "../../../include/Core/Mixer.hpp"
+
 namespace SuperHaxagon {
-	PlayerMusicSFML::PlayerMusicSFML(std::unique_ptr<sf::Music> music) : _music(std::move(music)) {}
+	PlayerMusicSFML::PlayerMusicSFML(Mixer& mixer, std::shared_ptr<MixerStream> stream) : _mixer(mixer), _stream(std::move(stream)) {}
 
 	PlayerMusicSFML::~PlayerMusicSFML() {
-		_music->stop();
+		_mixer.stopStream(_stream);
 	}
 
 	void PlayerMusicSFML::setLoop(const bool loop) {
-		_music->setLoop(loop);
+		_loop = loop;
+		_mixer.setStreamLoop(_stream, loop);
 	}
 
 	void PlayerMusicSFML::play() {
-		_music->play();
+		_mixer.playStream(_stream, _loop);
+		_playing = true;
 	}
 
 	void PlayerMusicSFML::pause() {
-		_music->pause();
+		_mixer.pauseStream(_stream);
+		_playing = false;
 	}
 
 	bool PlayerMusicSFML::isDone() const {
-		return _music->getStatus() == sf::SoundSource::Stopped;
+		return _stream->isDone();
 	}
 
 	double PlayerMusicSFML::getTime() const {
-		return _music->getPlayingOffset().asSeconds();
+		if (!_playing) return _clock.get();
+
+		// The mixer reports one block at a time
+		const auto position = _stream->getTime() - getLatency();
+		const auto granularity = static_cast<double>(Mixer::BLOCK_FRAMES) / Mixer::RATE;
+		return _clock.update(position, _now.getElapsedTime().asSeconds(), granularity);
+	}
+
+	double PlayerMusicSFML::getLatency() const {
+		return _mixer.getLatency();
 	}
 }
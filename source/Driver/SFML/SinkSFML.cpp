@@ -0,0 +1,48 @@
+#include "../../../include/Driver/SFML/SinkSFML.hpp"
+
+#include <algorithm>
+
+#include <SFML/System/Sleep.hpp>
+
+namespace SuperHaxagon {
+	SinkSFML::SinkSFML() {
+		initialize(Mixer::CHANNELS, Mixer::RATE);
+	}
+
+	SinkSFML::~SinkSFML() {
+		stop();
+	}
+
+	void SinkSFML::write(const int16_t* samples, const size_t frames) {
+		_writing.frames = std::min(frames, Mixer::BLOCK_FRAMES);
+		std::copy(samples, samples + _writing.frames * Mixer::CHANNELS, _writing.samples.begin());
+		while (!_blocks.push(std::move(_writing))) {
+			if (getStatus() != Playing) {
+				// Nobody is going to make room, drop the block but take as long
+				// as it would have to play, so the mixer doesn't spin on a core
+				sf::sleep(sf::seconds(static_cast<float>(Mixer::BLOCK_FRAMES) / Mixer::RATE));
+				return;
+			}
+
+			sf::sleep(sf::milliseconds(1));
+		}
+	}
+
+	double SinkSFML::getLatency() const {
+		// Everything waiting in the queue, plus what SFML has already taken
+		const auto blocks = _blocks.size() + SFML_BUFFERS;
+		return static_cast<double>(blocks * Mixer::BLOCK_FRAMES) / Mixer::RATE;
+	}
+
+	bool SinkSFML::onGetData(Chunk& data) {
+		// Underrun, play silence until the mixer catches up
+		if (!_blocks.pop(_playing)) {
+			_playing.samples.fill(0);
+			_playing.frames = Mixer::BLOCK_FRAMES;
+		}
+
+		data.samples = _playing.samples.data();
+		data.sampleCount = _playing.frames * Mixer::CHANNELS;
+		return true;
+	}
+}
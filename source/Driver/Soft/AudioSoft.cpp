@@ -0,0 +1,14 @@
+#include "../../../include/Driver/Soft/AudioSoft.hpp"
+
+#include "../../../include/Driver/Soft/PlayerSoft.hpp"
+
+namespace SuperHaxagon {
+	AudioSoft::AudioSoft(PlatformSoft& platform, const Stream stream) : _platform(platform), _stream(stream) {}
+
+	AudioSoft::~AudioSoft() = default;
+
+	std::unique_ptr<Player> AudioSoft::instantiate() {
+		if (_stream != Stream::INDIRECT) return nullptr;
+		return std::make_unique<PlayerSoft>(_platform);
+	}
+}
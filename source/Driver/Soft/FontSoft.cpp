@@ -0,0 +1,47 @@
+#include "../../../include/Driver/Soft/FontSoft.hpp"
+
+#include "../../../include/Driver/Soft/PlatformSoft.hpp"
+
+#include <cmath>
+
+namespace SuperHaxagon {
+	FontSoft::FontSoft(PlatformSoft& platform, const std::string& path, const double size, const bool blocks) :
+		_platform(platform),
+		_atlas(blocks ? GlyphAtlas(size * 2) : GlyphAtlas(path + ".ttf", size * 2)) {
+		if (!_atlas.isLoaded()) platform.message(Dbg::FATAL, "font", "could not load font " + path + ".ttf");
+	}
+
+	FontSoft::~FontSoft() = default;
+
+	double FontSoft::getHeight() const {
+		return _atlas.getAscent();
+	}
+
+	double FontSoft::getWidth(const std::string& text) const {
+		return _atlas.getWidth(text);
+	}
+
+	void FontSoft::draw(const Color& color, const Point& position, Alignment alignment, const std::string& text) {
+		if (!_atlas.isLoaded()) return;
+		_platform.getStats().add(Stat::TEXT_DRAWS);
+
+		Point cursor = position;
+		const auto width = getWidth(text);
+		if (alignment == Alignment::CENTER) cursor.x = position.x - width / 2;
+		if (alignment == Alignment::RIGHT) cursor.x = position.x - width;
+
+		_quads.clear();
+		_atlas.layout(text, cursor, _quads);
+
+		// Quads are one texel to a pixel, so the atlas is read straight from where each glyph starts
+		const auto stride = _atlas.getTextureWidth();
+		const auto& pixels = _atlas.getPixels();
+		for (const auto& quad : _quads) {
+			const auto u = static_cast<size_t>(std::lround(quad.uv0.x * _atlas.getTextureWidth()));
+			const auto v = static_cast<size_t>(std::lround(quad.uv0.y * _atlas.getTextureHeight()));
+			const auto w = static_cast<int>(std::lround(quad.size.x));
+			const auto h = static_cast<int>(std::lround(quad.size.y));
+			_platform.getRasterizer().glyph(color, quad.position, w, h, &pixels[v * stride + u], stride);
+		}
+	}
+}
@@ -0,0 +1,258 @@
+#include "../../../include/Driver/Soft/PlatformSoft.hpp"
+
+#include "../../../include/Core/Golden.hpp"
+#include "../../../include/Core/Mixer.hpp"
+#include "../../../include/Core/Twist.hpp"
+#include "../../../include/Driver/Soft/AudioSoft.hpp"
+#include "../../../include/Driver/Soft/FontSoft.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <sys/stat.h>
+
+namespace SuperHaxagon {
+	// Every allocation in the process, for golden budgets
+	static std::atomic<uint64_t> allocations{0};
+}
+
+// Only this driver counts, it is the one that checks budgets
+void* operator new(const std::size_t size) {
+	SuperHaxagon::allocations.fetch_add(1, std::memory_order_relaxed);
+	if (auto* memory = std::malloc(size ? size : 1)) return memory;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+	std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+	std::free(memory);
+}
+
+namespace SuperHaxagon {
+	// Mixed at the end of every frame, so the audio lines up with the frames exactly
+	static constexpr size_t AUDIO_FRAMES = static_cast<size_t>(Mixer::RATE / PlatformSoft::FRAME_RATE);
+
+	static int getEnvInt(const char* name, const int fallback) {
+		const auto* value = std::getenv(name);
+		return value ? std::atoi(value) : fallback;
+	}
+
+	PlatformSoft::PlatformSoft(const Dbg dbg) :
+		Platform(dbg),
+		_framebuffer(getEnvInt("SUPER_HAXAGON_WIDTH", 1280), getEnvInt("SUPER_HAXAGON_HEIGHT", 720)),
+		_rasterizer(static_cast<unsigned int>(std::max(getEnvInt("SUPER_HAXAGON_THREADS", 0), 0))) {
+		mkdir("./sdmc", 0755);
+
+		const auto* frames = std::getenv("SUPER_HAXAGON_FRAMES");
+		if (frames) _maxFrames = std::strtoull(frames, nullptr, 10);
+
+		const auto* dump = std::getenv("SUPER_HAXAGON_DUMP");
+		if (dump) _dump = dump;
+
+		const auto* stats = std::getenv("SUPER_HAXAGON_STATS");
+		if (stats) _stats.setPeriod(std::strtoull(stats, nullptr, 10));
+
+		// Driven by hand rather than on its own thread, so that runs repeat exactly
+		_mixer = std::make_unique<Mixer>();
+		_audio.resize(AUDIO_FRAMES * Mixer::CHANNELS);
+		const auto* wav = std::getenv("SUPER_HAXAGON_WAV");
+		if (wav) {
+			_wav = std::make_unique<MixerSinkFile>(wav);
+			if (!_wav->isOpen()) {
+				PlatformSoft::message(Dbg::WARN, "audio", std::string("cannot write ") + wav);
+				_wav = nullptr;
+			}
+		}
+
+		const auto* golden = std::getenv("SUPER_HAXAGON_GOLDEN");
+		if (golden) {
+			// Scores show up on the menu, so runs start without any and leave the real ones alone
+			_sdmc += "/golden";
+			mkdir(_sdmc.c_str(), 0755);
+			std::remove((_sdmc + "/scores.db").c_str());
+
+			_golden = std::make_unique<Golden>(*this, golden, std::getenv("SUPER_HAXAGON_GOLDEN_UPDATE") != nullptr);
+			if (!_maxFrames) _maxFrames = _golden->getFrames();
+		}
+
+		_start = std::chrono::steady_clock::now();
+
+		PlatformSoft::message(Dbg::INFO, "platform", std::to_string(_framebuffer.getWidth()) + "x" + std::to_string(_framebuffer.getHeight()) + " on " + std::to_string(_rasterizer.getThreads()) + " threads");
+	}
+
+	void PlatformSoft::vmessage(const Dbg dbg, const char* where, const char* format, va_list args) {
+		_log.vpush(dbg, where, format, args);
+	}
+
+	PlatformSoft::~PlatformSoft() = default;
+
+	bool PlatformSoft::loop() {
+		// The game has ended the last frame by the time it asks for the next one
+		if (_golden && !_golden->isLoaded()) return false;
+		if (_frames > _mixed) {
+			_mixer->render(_audio.data(), AUDIO_FRAMES);
+			_mixer->collect();
+			_mixed = _frames;
+			if (_wav) _wav->write(_audio.data(), AUDIO_FRAMES);
+			if (_golden) _golden->addAudio(_audio.data(), AUDIO_FRAMES);
+
+			const auto dropped = _mixer->takeDropped();
+			if (dropped) LOG_MESSAGEF(*this, Dbg::WARN, "mixer", "%u commands dropped, the queue was full", dropped);
+		}
+
+		if (_golden) _golden->endFrame(_frames, _framebuffer, _stats, allocations.load(std::memory_order_relaxed));
+
+		return _framebuffer.getWidth() > 0 && _framebuffer.getHeight() > 0 && (!_maxFrames || _frames < _maxFrames);
+	}
+
+	double PlatformSoft::getDilation() {
+		return 1.0;
+	}
+
+	std::string PlatformSoft::getPath(const std::string& partial) {
+		return _sdmc + partial;
+	}
+
+	std::string PlatformSoft::getPathRom(const std::string& partial) {
+		return std::string("./romfs") + partial;
+	}
+
+	std::unique_ptr<Audio> PlatformSoft::loadAudio(const std::string&, const Stream stream) {
+		return std::make_unique<AudioSoft>(*this, stream);
+	}
+
+	std::unique_ptr<Font> PlatformSoft::loadFont(const std::string& path, const int size) {
+		// Golden frames are hashed, so they can't depend on how the font library rasterizes
+		return std::make_unique<FontSoft>(*this, path, size, _golden != nullptr);
+	}
+
+	void PlatformSoft::loadSFX() {
+		Platform::loadSFX();
+
+		// The mixer plays straight out of the sound bank
+		for (auto i = 0; i < static_cast<int>(SoundId::LAST); i++) {
+			const auto& sound = _sounds->get(static_cast<SoundId>(i));
+			if (!sound.samples) continue;
+			auto pcm = std::make_shared<Pcm>();
+			pcm->samples = sound.samples;
+			pcm->frames = sound.frames;
+			pcm->channels = sound.channels;
+			pcm->rate = sound.rate;
+			_sfx[i] = std::move(pcm);
+		}
+	}
+
+	void PlatformSoft::playSFX(const SoundId id) {
+		const auto& pcm = _sfx[static_cast<size_t>(id)];
+		if (!pcm) return;
+		_mixer->playSFX(pcm, Mixer::DEFAULT_POLYPHONY);
+	}
+
+	void PlatformSoft::playBGM(Audio& audio) {
+		_bgm = audio.instantiate();
+		if (!_bgm) return;
+		_bgm->setLoop(true);
+		_bgm->play();
+	}
+
+	std::string PlatformSoft::getButtonName(const Buttons& button) {
+		if (button.back) return "BACK";
+		if (button.select) return "SELECT";
+		if (button.left) return "LEFT";
+		if (button.right) return "RIGHT";
+		if (button.quit) return "QUIT";
+		return "?";
+	}
+
+	Buttons PlatformSoft::getPressed() {
+		return _golden ? _golden->getPressed(_frames) : Buttons{};
+	}
+
+	Point PlatformSoft::getScreenDim() const {
+		return {static_cast<double>(_framebuffer.getWidth()), static_cast<double>(_framebuffer.getHeight())};
+	}
+
+	void PlatformSoft::screenBegin() {
+		_rasterizer.begin(_framebuffer, COLOR_BLACK);
+	}
+
+	void PlatformSoft::screenSwap() {
+		// Nothing to do, there is only one screen
+	}
+
+	void PlatformSoft::screenFinalize() {
+		const auto start = std::chrono::steady_clock::now();
+		_rasterizer.finish();
+		_raster += std::chrono::steady_clock::now() - start;
+		_frames++;
+	}
+
+	void PlatformSoft::screenSkip() {
+		// Skipped frames still count, music and SUPER_HAXAGON_FRAMES go by them
+		_frames++;
+		_skipped++;
+	}
+
+	void PlatformSoft::drawPoly(const Color& color, const std::vector<Point>& points) {
+		if (points.size() < 3) return;
+		_stats.addPoly(points.size());
+
+		const auto& transform = getTransform();
+		const auto first = transformPoint(transform, points[0]);
+		auto last = transformPoint(transform, points[1]);
+		for (size_t i = 2; i < points.size(); i++) {
+			const auto next = transformPoint(transform, points[i]);
+			_rasterizer.triangle(color, first, last, next);
+			last = next;
+		}
+	}
+
+	bool PlatformSoft::drawStrip(const Color& color, const std::vector<Point>& points) {
+		_stats.addPoly(points.size());
+		const auto& transform = getTransform();
+		_points.clear();
+		for (const auto& point : points) _points.push_back(transformPoint(transform, point));
+		for (size_t i = 2; i < _points.size(); i++) _rasterizer.triangle(color, _points[i - 2], _points[i - 1], _points[i]);
+		return true;
+	}
+
+	std::unique_ptr<Twist> PlatformSoft::getTwister() {
+		// Always the same seed, so that two runs draw the same frames
+		return std::make_unique<Twist>(
+			std::make_unique<std::seed_seq>(std::initializer_list<int>{0})
+		);
+	}
+
+	bool PlatformSoft::isImmortal() {
+		return _golden && _golden->isImmortal(_frames);
+	}
+
+	void PlatformSoft::shutdown() {
+		if (_frames) {
+			const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - _start;
+			const std::chrono::duration<double, std::milli> raster = _raster;
+			message(Dbg::INFO, "platform", std::to_string(_frames) + " frames, " + std::to_string(_skipped) + " skipped, " + std::to_string(elapsed.count() / _frames) + " ms per frame, " + std::to_string(raster.count() / _frames) + " ms rasterizing");
+			message(Dbg::INFO, "stats", _stats.getSummary());
+		}
+
+		if (!_dump.empty()) {
+			if (_framebuffer.write(_dump)) message(Dbg::INFO, "platform", "wrote " + _dump);
+			else message(Dbg::WARN, "platform", "could not write " + _dump);
+		}
+
+		if (_golden) _golden->finish();
+	}
+
+	int PlatformSoft::getExitCode() {
+		return _golden && !_golden->hasPassed() ? 1 : 0;
+	}
+
+	void PlatformSoft::message(const Dbg dbg, const std::string& where, const std::string& message) {
+		_log.push(dbg, where, message);
+	}
+}
@@ -0,0 +1,29 @@
+#include "../../../include/Driver/Soft/PlayerSoft.hpp"
+
+#include "../../../include/Driver/Soft/PlatformSoft.hpp"
+
+namespace SuperHaxagon {
+	PlayerSoft::PlayerSoft(PlatformSoft& platform) : _platform(platform) {}
+
+	PlayerSoft::~PlayerSoft() = default;
+
+	void PlayerSoft::play() {
+		if (_playing) return;
+		_start = _platform.getFrames() - _paused;
+		_playing = true;
+	}
+
+	void PlayerSoft::pause() {
+		if (!_playing) return;
+		_paused = getFrames();
+		_playing = false;
+	}
+
+	double PlayerSoft::getTime() const {
+		return static_cast<double>(getFrames()) / PlatformSoft::FRAME_RATE;
+	}
+
+	uint64_t PlayerSoft::getFrames() const {
+		return _playing ? _platform.getFrames() - _start : _paused;
+	}
+}
@@ -0,0 +1,367 @@
+#include "../../../include/Driver/Soft/Rasterizer.hpp"
+
+#include "../../../include/Core/Trace.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#define SUPER_HAXAGON_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace SuperHaxagon {
+	// Bounds are clamped to this before they turn into ints, way past any screen
+	static constexpr double COORD_MAX = 1 << 24;
+
+	// Edges have to clear a tile by this much, relative to their length, for it to count as fully covered.
+	// Keeps the whole tile shortcut from disagreeing with what the per pixel test would have said.
+	static constexpr double FULL_MARGIN = 1.0 / 1024.0;
+
+	static int clampCoord(const double value) {
+		return static_cast<int>(std::max(-COORD_MAX, std::min(COORD_MAX, value)));
+	}
+
+	/**
+	 * Same as dst + (src - dst) * alpha / 255, rounded. Both SIMD and
+	 * scalar paths use this exact formula, so pixels don't depend on which one touched them.
+	 */
+	static uint32_t blend(const uint32_t dst, const uint32_t src, const uint32_t alpha) {
+		uint32_t out = 0;
+		for (auto shift = 0; shift < 32; shift += 8) {
+			auto value = ((src >> shift) & 0xFF) * alpha + ((dst >> shift) & 0xFF) * (255 - alpha) + 128;
+			value = (value + (value >> 8)) >> 8;
+			out |= value << shift;
+		}
+
+		return out;
+	}
+
+	static bool inside(const float value, const bool inclusive) {
+		return value > 0.0f || (inclusive && value == 0.0f);
+	}
+
+#ifdef SUPER_HAXAGON_SSE2
+	/**
+	 * Four pixels of blend, with src already multiplied by alpha and with the rounding added.
+	 */
+	static __m128i blend4(const __m128i dst, const __m128i srcLo, const __m128i srcHi, const __m128i inverse) {
+		const auto zero = _mm_setzero_si128();
+		auto lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(dst, zero), inverse), srcLo);
+		auto hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(dst, zero), inverse), srcHi);
+		lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+		hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+		return _mm_packus_epi16(lo, hi);
+	}
+
+	static __m128i premultiply(const uint32_t src, const uint32_t alpha) {
+		const auto channels = _mm_unpacklo_epi8(_mm_set1_epi32(static_cast<int>(src)), _mm_setzero_si128());
+		const auto scaled = _mm_mullo_epi16(channels, _mm_set1_epi16(static_cast<short>(alpha)));
+		return _mm_add_epi16(scaled, _mm_set1_epi16(128));
+	}
+
+	static __m128 inside4(const __m128 value, const bool inclusive) {
+		const auto zero = _mm_setzero_ps();
+		const auto above = _mm_cmpgt_ps(value, zero);
+		return inclusive ? _mm_or_ps(above, _mm_cmpeq_ps(value, zero)) : above;
+	}
+#endif
+
+	Rasterizer::Rasterizer(unsigned int threads) {
+		if (threads == 0) threads = std::max(std::thread::hardware_concurrency(), 1u);
+		for (auto i = 1u; i < threads; i++) {
+			_workers.emplace_back([this] {
+				TRACE_THREAD("raster");
+				uint64_t seen = 0;
+				while (true) {
+					{
+						std::unique_lock<std::mutex> lock(_mutex);
+						_wake.wait(lock, [&] {return _quit || _generation != seen;});
+						if (_quit) return;
+						seen = _generation;
+					}
+
+					work();
+
+					std::lock_guard<std::mutex> lock(_mutex);
+					if (--_busy == 0) _done.notify_one();
+				}
+			});
+		}
+	}
+
+	Rasterizer::~Rasterizer() {
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_quit = true;
+		}
+
+		_wake.notify_all();
+		for (auto& worker : _workers) worker.join();
+	}
+
+	void Rasterizer::begin(Framebuffer& target, const Color& clear) {
+		_target = &target;
+		_clear = Framebuffer::pack({clear.r, clear.g, clear.b, 0xFF});
+		_tilesX = (target.getWidth() + TILE_SIZE - 1) / TILE_SIZE;
+		_tilesY = (target.getHeight() + TILE_SIZE - 1) / TILE_SIZE;
+
+		// Bins keep their memory between frames, most frames look a lot like the last one
+		_commands.clear();
+		_bins.resize(static_cast<size_t>(_tilesX) * _tilesY);
+		for (auto& bin : _bins) bin.clear();
+	}
+
+	void Rasterizer::triangle(const Color& color, const Point& a, const Point& b, const Point& c) {
+		if (!_target || color.a == 0) return;
+
+		// Twice the area, positive if the points go clockwise on screen
+		const auto area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+		if (!std::isfinite(area) || area == 0) return;
+
+		const Point* points[3] = {&a, &b, &c};
+		if (area < 0) std::swap(points[1], points[2]);
+
+		Command command{};
+		command.color = Framebuffer::pack({color.r, color.g, color.b, 0xFF});
+		command.alpha = color.a;
+
+		for (auto i = 0; i < 3; i++) {
+			// Worked out from the same end no matter the direction, so the triangle
+			// on the other side of a shared edge gets exactly the negative of it
+			const auto& from = *points[i];
+			const auto& to = *points[(i + 1) % 3];
+			const auto flip = to.x < from.x || (to.x == from.x && to.y < from.y);
+			const auto& p = flip ? to : from;
+			const auto& q = flip ? from : to;
+
+			auto& edge = command.edges[i];
+			edge.a = p.y - q.y;
+			edge.b = q.x - p.x;
+			edge.c = -(edge.a * p.x + edge.b * p.y);
+			if (flip) {
+				edge.a = -edge.a;
+				edge.b = -edge.b;
+				edge.c = -edge.c;
+			}
+
+			// Only one of two opposite edges can be inclusive, so a shared edge is drawn exactly once
+			edge.inclusive = edge.a > 0 || (edge.a == 0 && edge.b > 0);
+		}
+
+		const auto minX = std::min({a.x, b.x, c.x});
+		const auto minY = std::min({a.y, b.y, c.y});
+		const auto maxX = std::max({a.x, b.x, c.x});
+		const auto maxY = std::max({a.y, b.y, c.y});
+		command.x0 = std::max(clampCoord(std::floor(minX)), 0);
+		command.y0 = std::max(clampCoord(std::floor(minY)), 0);
+		command.x1 = std::min(clampCoord(std::floor(maxX)) + 1, _target->getWidth());
+		command.y1 = std::min(clampCoord(std::floor(maxY)) + 1, _target->getHeight());
+		if (command.x0 >= command.x1 || command.y0 >= command.y1) return;
+
+		_commands.push_back(command);
+		bin(static_cast<uint32_t>(_commands.size() - 1));
+	}
+
+	void Rasterizer::glyph(const Color& color, const Point& position, const int width, const int height, const uint8_t* pixels, const int stride) {
+		if (!_target || color.a == 0 || width <= 0 || height <= 0) return;
+
+		Command command{};
+		command.color = Framebuffer::pack({color.r, color.g, color.b, 0xFF});
+		command.alpha = color.a;
+		command.glyph = true;
+		command.x0 = clampCoord(std::round(position.x));
+		command.y0 = clampCoord(std::round(position.y));
+		command.x1 = command.x0 + width;
+		command.y1 = command.y0 + height;
+		command.pixels = pixels;
+		command.stride = stride;
+
+		if (command.x1 <= 0 || command.y1 <= 0 || command.x0 >= _target->getWidth() || command.y0 >= _target->getHeight()) return;
+
+		_commands.push_back(command);
+		bin(static_cast<uint32_t>(_commands.size() - 1));
+	}
+
+	void Rasterizer::finish() {
+		TRACE_ZONE("Rasterizer::finish");
+		if (!_target) return;
+
+		_next = 0;
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_generation++;
+			_busy = static_cast<unsigned int>(_workers.size());
+		}
+
+		_wake.notify_all();
+		work();
+
+		std::unique_lock<std::mutex> lock(_mutex);
+		_done.wait(lock, [&] {return _busy == 0;});
+		_target = nullptr;
+	}
+
+	void Rasterizer::bin(const uint32_t index) {
+		const auto& command = _commands[index];
+		const auto tx0 = std::max(command.x0, 0) / TILE_SIZE;
+		const auto ty0 = std::max(command.y0, 0) / TILE_SIZE;
+		const auto tx1 = (std::min(command.x1, _target->getWidth()) - 1) / TILE_SIZE;
+		const auto ty1 = (std::min(command.y1, _target->getHeight()) - 1) / TILE_SIZE;
+
+		for (auto ty = ty0; ty <= ty1; ty++) {
+			for (auto tx = tx0; tx <= tx1; tx++) {
+				auto& bin = _bins[static_cast<size_t>(ty) * _tilesX + tx];
+				if (command.glyph) {
+					bin.push_back(index);
+					continue;
+				}
+
+				// Pixel centers at the corners of the tile, as far as the screen goes
+				const auto left = tx * TILE_SIZE + 0.5;
+				const auto top = ty * TILE_SIZE + 0.5;
+				const auto right = std::min((tx + 1) * TILE_SIZE, _target->getWidth()) - 0.5;
+				const auto bottom = std::min((ty + 1) * TILE_SIZE, _target->getHeight()) - 0.5;
+
+				auto full = true;
+				auto outside = false;
+				for (const auto& edge : command.edges) {
+					// The corners that are the furthest in and out of this edge
+					const auto most = edge.a * (edge.a > 0 ? right : left) + edge.b * (edge.b > 0 ? bottom : top) + edge.c;
+					const auto least = edge.a * (edge.a > 0 ? left : right) + edge.b * (edge.b > 0 ? top : bottom) + edge.c;
+					if (most < 0 || (most == 0 && !edge.inclusive)) outside = true;
+					if (least <= (std::abs(edge.a) + std::abs(edge.b)) * FULL_MARGIN) full = false;
+				}
+
+				if (!outside) bin.push_back(index | (full ? FULL : 0));
+			}
+		}
+	}
+
+	void Rasterizer::work() {
+		TRACE_ZONE("Rasterizer::work");
+		const auto tiles = _bins.size();
+		for (auto tile = _next++; tile < tiles; tile = _next++) drawTile(tile);
+	}
+
+	void Rasterizer::drawTile(const size_t tile) {
+		const auto tx = static_cast<int>(tile % _tilesX) * TILE_SIZE;
+		const auto ty = static_cast<int>(tile / _tilesX) * TILE_SIZE;
+		const auto tx1 = std::min(tx + TILE_SIZE, _target->getWidth());
+		const auto ty1 = std::min(ty + TILE_SIZE, _target->getHeight());
+
+		for (auto y = ty; y < ty1; y++) {
+			auto* row = _target->getRow(y);
+			std::fill(row + tx, row + tx1, _clear);
+		}
+
+		for (const auto entry : _bins[tile]) {
+			const auto& command = _commands[entry & ~FULL];
+			const auto x0 = std::max(command.x0, tx);
+			const auto y0 = std::max(command.y0, ty);
+			const auto x1 = std::min(command.x1, tx1);
+			const auto y1 = std::min(command.y1, ty1);
+			if (x0 >= x1 || y0 >= y1) continue;
+
+			if (command.glyph) drawGlyph(command, x0, y0, x1, y1);
+			else drawTriangle(command, (entry & FULL) != 0, x0, y0, x1, y1);
+		}
+	}
+
+	void Rasterizer::drawTriangle(const Command& command, const bool full, const int x0, const int y0, const int x1, const int y1) {
+		const auto src = command.color;
+		const uint32_t alpha = command.alpha;
+		const auto opaque = alpha == 0xFF;
+
+		// Edges are evaluated from the corner of the tile, never the triangle's
+		// bounds, so that every triangle works a pixel out with the same floats
+		const auto tx = x0 / TILE_SIZE * TILE_SIZE;
+		const auto ty = y0 / TILE_SIZE * TILE_SIZE;
+		float ea[3];
+		float eb[3];
+		float ec[3];
+		for (auto i = 0; i < 3; i++) {
+			const auto& edge = command.edges[i];
+			ea[i] = static_cast<float>(edge.a);
+			eb[i] = static_cast<float>(edge.b);
+			ec[i] = static_cast<float>(edge.a * (tx + 0.5) + edge.b * (ty + 0.5) + edge.c);
+		}
+
+		// Groups of four are lined up with the tile, so the same pixel always
+		// goes down the same path. Only a ragged screen edge ends up scalar.
+		const auto width = _target->getWidth();
+		const auto groupStart = (x0 - tx) & ~3;
+
+#ifdef SUPER_HAXAGON_SSE2
+		const auto srcLo = premultiply(src, alpha);
+		const auto srcHi = srcLo;
+		const auto inverse = _mm_set1_epi16(static_cast<short>(255 - alpha));
+		const auto srcOpaque = _mm_set1_epi32(static_cast<int>(src));
+		const auto lanes = _mm_setr_epi32(0, 1, 2, 3);
+		const auto lo = _mm_set1_epi32(x0 - tx - 1);
+		const auto hi = _mm_set1_epi32(x1 - tx);
+		__m128 va[3];
+		for (auto i = 0; i < 3; i++) va[i] = _mm_set1_ps(ea[i]);
+#endif
+
+		for (auto y = y0; y < y1; y++) {
+			auto* row = _target->getRow(y);
+			const auto dy = static_cast<float>(y - ty);
+			float rows[3];
+			for (auto i = 0; i < 3; i++) rows[i] = ec[i] + eb[i] * dy;
+
+			auto dx = groupStart;
+
+#ifdef SUPER_HAXAGON_SSE2
+			__m128 vrow[3];
+			for (auto i = 0; i < 3; i++) vrow[i] = _mm_set1_ps(rows[i]);
+
+			for (; tx + dx + 4 <= width && tx + dx < x1; dx += 4) {
+				const auto index = _mm_add_epi32(_mm_set1_epi32(dx), lanes);
+				auto mask = _mm_and_si128(_mm_cmpgt_epi32(index, lo), _mm_cmplt_epi32(index, hi));
+				if (!full) {
+					const auto fx = _mm_cvtepi32_ps(index);
+					for (auto i = 0; i < 3; i++) {
+						const auto value = _mm_add_ps(vrow[i], _mm_mul_ps(va[i], fx));
+						mask = _mm_and_si128(mask, _mm_castps_si128(inside4(value, command.edges[i].inclusive)));
+					}
+				}
+
+				if (_mm_movemask_epi8(mask) == 0) continue;
+
+				auto* pixels = reinterpret_cast<__m128i*>(row + tx + dx);
+				const auto dst = _mm_loadu_si128(pixels);
+				const auto color = opaque ? srcOpaque : blend4(dst, srcLo, srcHi, inverse);
+				_mm_storeu_si128(pixels, _mm_or_si128(_mm_and_si128(mask, color), _mm_andnot_si128(mask, dst)));
+			}
+#endif
+
+			for (; tx + dx < x1; dx++) {
+				if (tx + dx < x0) continue;
+
+				auto covered = full;
+				if (!covered) {
+					const auto fx = static_cast<float>(dx);
+					covered = true;
+					for (auto i = 0; i < 3 && covered; i++) covered = inside(rows[i] + ea[i] * fx, command.edges[i].inclusive);
+				}
+
+				if (!covered) continue;
+
+				auto& pixel = row[tx + dx];
+				pixel = opaque ? src : blend(pixel, src, alpha);
+			}
+		}
+	}
+
+	void Rasterizer::drawGlyph(const Command& command, const int x0, const int y0, const int x1, const int y1) {
+		for (auto y = y0; y < y1; y++) {
+			auto* row = _target->getRow(y);
+			const auto* coverage = command.pixels + static_cast<size_t>(y - command.y0) * command.stride;
+			for (auto x = x0; x < x1; x++) {
+				const auto alpha = (static_cast<uint32_t>(command.alpha) * coverage[x - command.x0] + 127) / 255;
+				if (alpha) row[x] = blend(row[x], command.color, alpha);
+			}
+		}
+	}
+}
@@ -3,35 +3,51 @@
 #include <ctime>
 
 namespace SuperHaxagon {
+	std::atomic<uint64_t> PlayerMusSwitch::_consumed{0};
+
 	PlayerMusSwitch::PlayerMusSwitch(Mix_Music* music) : _music(music) {}
 
 	PlayerMusSwitch::~PlayerMusSwitch() {
 		Mix_HaltMusic();
 	}
 
+	void PlayerMusSwitch::postMix(void*, Uint8*, const int length) {
+		// Runs on the audio thread, right before the buffer is handed to the device
+		if (!Mix_PlayingMusic() || Mix_PausedMusic()) return;
+
+		auto rate = 0;
+		Uint16 format = 0;
+		auto channels = 0;
+		if (!Mix_QuerySpec(&rate, &format, &channels)) return;
+
+		const auto frameBytes = channels * SDL_AUDIO_BITSIZE(format) / 8;
+		if (frameBytes > 0) _consumed += length / frameBytes;
+	}
+
 	void PlayerMusSwitch::setLoop(const bool loop) {
 		_loop = loop;
 	}
 
 	void PlayerMusSwitch::play() {
+		_playing = true;
+
 		if (isDone()) {
 			// For the switch, we only play the music once and restart it in the platform.
 			// This is because we need to detect when the music is over in order to reset the timers.
 			// The Switch platform specifically continuously calls play, so if we are not
 			// playing anything restart the music.
-			_start = getNow();
+			_consumed = 0;
+			_clock.reset();
 			Mix_PlayMusic(_music, 1);
 			return;
 		}
 
 		// We are not done, so resume the currently playing music.
-		if (_diff > 0) _start += getNow() - _diff;
-		_diff = 0;
 		Mix_ResumeMusic();
 	}
 
 	void PlayerMusSwitch::pause() {
-		_diff = getNow();
+		_playing = false;
 		Mix_PauseMusic();
 	}
 
@@ -41,17 +57,26 @@ namespace SuperHaxagon {
 	}
 
 	double PlayerMusSwitch::getTime() const {
-		// If we set diff (paused), we are frozen in time. Otherwise, the current timestamp is
-		// the system minus the start of the song.
-		return _diff > 0 ? _diff - _start : getNow() - _start;
+		// Frozen in time while paused
+		if (!_playing) return _clock.get();
+
+		auto rate = RATE;
+		Uint16 format = 0;
+		auto channels = 0;
+		Mix_QuerySpec(&rate, &format, &channels);
+
+		// The device takes a whole buffer at a time, which is also how long it takes to hear it
+		const auto position = static_cast<double>(_consumed.load()) / rate - getLatency();
+		return _clock.update(position, getNow(), getLatency());
+	}
+
+	double PlayerMusSwitch::getLatency() const {
+		return static_cast<double>(BUFFER_FRAMES) / RATE;
 	}
 
 	double PlayerMusSwitch::getNow() const {
-		// Note that this is kind of a shitty way to do this: if the user presses the
-		// home button while the game is running (and not at a game over screen) the
-		// clock will get offset from the music. I personally am not going to fix this,
-		// but if someone ever stumbles across this comment feel free to do something
-		// about it.
+		// Only used to smooth things out between buffers, so it doesn't matter that
+		// this keeps running while the console is suspended.
 		timespec time{};
 		clock_gettime(CLOCK_MONOTONIC, &time);
 		double seconds = time.tv_sec;
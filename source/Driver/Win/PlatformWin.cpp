@@ -3,7 +3,6 @@
 #include "../../../include/Core/Twist.hpp"
 
 #include <direct.h>
-#include <iostream>
 #include <windows.h>
 #include <filesystem>
 
@@ -30,14 +29,12 @@ namespace SuperHaxagon {
 	}
 
 	void PlatformWin::message(const Dbg dbg, const std::string& where, const std::string& message) {
-		if (dbg == Dbg::INFO) {
-			std::cout << "[win:info] " + where + ": " + message << std::endl;
-		} else if (dbg == Dbg::WARN) {
-			std::cout << "[win:warn] " + where + ": " + message << std::endl;
-		} else if (dbg == Dbg::FATAL) {
-			std::cerr << "[win:fatal] " + where + ": " + message << std::endl;
-			//MessageBox(nullptr, (where + ": " + message).c_str(), "A fatal error occurred!", MB_OK);
-		}
+		_log.push(dbg, where, message);
+		//if (dbg == Dbg::FATAL) MessageBox(nullptr, (where + ": " + message).c_str(), "A fatal error occurred!", MB_OK);
+	}
+
+	void PlatformWin::vmessage(const Dbg dbg, const char* where, const char* format, va_list args) {
+		_log.vpush(dbg, where, format, args);
 	}
 
 	std::unique_ptr<Twist> PlatformWin::getTwister() {
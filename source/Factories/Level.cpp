@@ -1,6 +1,8 @@
 #include "../../include/Factories/Level.hpp"
 
 #include "../../include/Core/Game.hpp"
+#include "../../include/Core/Stats.hpp"
+#include "../../include/Core/Trace.hpp"
 #include "../../include/Core/Twist.hpp"
 #include "../../include/Driver/Platform.hpp"
 
@@ -28,7 +30,8 @@ namespace SuperHaxagon {
 
 	Level::~Level() = default;
 
-	void Level::update(Twist& rng, const double patternDistDelete, const double patternDistCreate, const double dilation) {
+	void Level::update(Twist& rng, Stats& stats, const double patternDistDelete, const double patternDistCreate, const double dilation) {
+		TRACE_ZONE("Level::update");
 		// Update frame
 		_frame += dilation;
 		
@@ -64,11 +67,15 @@ namespace SuperHaxagon {
 
 		// Move the walls (either closer to the player or away from the hexagon)
 		if (_multiplierWalls > 0) {
-			advanceWalls(rng, patternDistDelete, patternDistCreate);
+			advanceWalls(rng, stats, patternDistDelete, patternDistCreate);
 		} else {
-			reverseWalls(rng, patternDistDelete, patternDistCreate);
+			reverseWalls(rng, stats, patternDistDelete, patternDistCreate);
 		}
 
+		size_t walls = 0;
+		for (const auto& pattern : _patterns) walls += pattern.getWalls().size();
+		stats.set(Stat::LIVE_WALLS, walls);
+
 		// Rotate level
 		if (_rotateToZero) {
 			// Trying to snap back to zero
@@ -100,6 +107,7 @@ namespace SuperHaxagon {
 	}
 
 	void Level::draw(Game& game, const double scale, const double offsetWall) const {
+		TRACE_ZONE("Level::draw");
 
 		// Calculate colors
 		const auto percentTween = _tweenFrame / _factory->getSpeedPulse();
@@ -115,21 +123,21 @@ namespace SuperHaxagon {
 
 		game.drawBackground(_bgInverted ? bg2 : bg1, _bgInverted ? bg1 : bg2, center, diagonal, _rotation, _sidesTween);
 
-		// Draw shadows
+		// Draw shadows, and keep the shapes so the real thing doesn't have to work them out again
 		const auto cursorDistance = SCALE_HEX_LENGTH + SCALE_HUMAN_PADDING;
-		const Point offsetFocus = {center.x + shadow.x, center.y + shadow.y};
-		game.drawPatterns(COLOR_SHADOW, offsetFocus, _patterns, _rotation, _sidesTween, offsetWall + _pulse, scale);
-		game.drawRegular(COLOR_SHADOW, offsetFocus, (SCALE_HEX_LENGTH + _pulse) * scale, _rotation, _sidesTween);
-		if (_showCursor) game.drawCursor(COLOR_SHADOW, offsetFocus, _cursorPos, _rotation, _pulse + cursorDistance, scale);
-
-		// Draw real thing
-		game.drawPatterns(fg, center, _patterns, _rotation, _sidesTween, offsetWall + _pulse, scale);
-		game.drawRegular(fg, center, (SCALE_HEX_LENGTH + _pulse) * scale, _rotation, _sidesTween);
+		game.beginShadow(shadow);
+		game.drawPatterns(COLOR_SHADOW, center, _patterns, _rotation, _sidesTween, offsetWall + _pulse, scale);
+		game.drawRegular(COLOR_SHADOW, center, (SCALE_HEX_LENGTH + _pulse) * scale, _rotation, _sidesTween);
+		if (_showCursor) game.drawCursor(COLOR_SHADOW, center, _cursorPos, _rotation, _pulse + cursorDistance, scale);
+		game.endShadow();
+
+		// Draw real thing, the cursor sits outside the hexagon so the inside can go last
+		game.drawShadowed(fg);
 		game.drawRegular(bg2, center, (SCALE_HEX_LENGTH - SCALE_HEX_BORDER + _pulse) * scale, _rotation, _sidesTween);
-		if (_showCursor) game.drawCursor(fg, center, _cursorPos, _rotation, _pulse + cursorDistance, scale);
 	}
 
 	Movement Level::collision(const double cursorDistance, const double dilation) const {
+		TRACE_ZONE("Level::collision");
 		auto collision = Movement::CAN_MOVE;
 
 		// For all patterns (technically only need to check front two)
@@ -209,11 +217,12 @@ namespace SuperHaxagon {
 		}
 	}
 
-	void Level::advanceWalls(Twist& rng, const double patternDistDelete, const double patternDistCreate) {
+	void Level::advanceWalls(Twist& rng, Stats& stats, const double patternDistDelete, const double patternDistCreate) {
 		// Shift patterns forward
 		if (_patterns.front().getFurthestWallDistance() < patternDistDelete) {
 			_sidesLast = _patterns.front().getSides();
 			_patterns.pop_front();
+			stats.add(Stat::PATTERN_RETIREMENTS);
 			_sidesCurrent = _patterns.front().getSides();
 
 			// Delay the level if the shifted pattern does  not have the same sides as the last.
@@ -226,12 +235,14 @@ namespace SuperHaxagon {
 		// Create new pattern if needed
 		if (_patterns.size() < 2 || _patterns.back().getFurthestWallDistance() < patternDistCreate) {
 			_patterns.emplace_back(getRandomPattern(rng).instantiate(rng, _patterns.back().getFurthestWallDistance()));
+			stats.add(Stat::PATTERN_SPAWNS);
 		}
 	}
 
-	auto Level::reverseWalls(Twist& rng, const double patternDistDelete, const double patternDistCreate) -> void {
+	auto Level::reverseWalls(Twist& rng, Stats& stats, const double patternDistDelete, const double patternDistCreate) -> void {
 		if (_patterns.back().getClosestWallDistance() > patternDistDelete && _patterns.size() > 1) {
 			_patterns.pop_back();
+			stats.add(Stat::PATTERN_RETIREMENTS);
 		}
 
 		// Create a new pattern at the front.
@@ -241,6 +252,7 @@ namespace SuperHaxagon {
 			_frontGap = pattern.getClosestWallDistance() * 1.5; // Too small of a gap otherwise
 			pattern.advance(pattern.getFurthestWallDistance());
 			_patterns.emplace_front(pattern);
+			stats.add(Stat::PATTERN_SPAWNS);
 			if (pattern.getSides() != _sidesCurrent) setWinSides(pattern.getSides());
 		}
 	}
@@ -281,7 +293,7 @@ namespace SuperHaxagon {
 		_location = location;
 
 		if (!readCompare(file, LEVEL_HEADER)) {
-			platform.message(Dbg::WARN, "level", "level header invalid!");
+			LOG_MESSAGE(platform, Dbg::WARN, "level", "level header invalid!");
 			return;
 		}
 
@@ -326,13 +338,13 @@ namespace SuperHaxagon {
 			}
 
 			if (!found) {
-				platform.message(Dbg::WARN, "level", "could not find pattern " + search + " for " + _name);
+				LOG_MESSAGEF(platform, Dbg::WARN, "level", "could not find pattern %s for %s", search.c_str(), _name.c_str());
 				return;
 			}
 		}
 
 		if (!readCompare(file, LEVEL_FOOTER)) {
-			platform.message(Dbg::WARN, "level", "level footer invalid!");
+			LOG_MESSAGE(platform, Dbg::WARN, "level", "level footer invalid!");
 			return;
 		}
 
@@ -3,11 +3,29 @@
 #include "../../include/Core/Twist.hpp"
 #include "../../include/Driver/Platform.hpp"
 
+#include <algorithm>
+#include <tuple>
+
 namespace SuperHaxagon {
 	const char* PatternFactory::PATTERN_HEADER = "PTN1.1";
 	const char* PatternFactory::PATTERN_FOOTER = "ENDPTN";
 
-	Pattern::Pattern(std::vector<Wall>& walls, const int sides) : _walls(std::move(walls)), _sides(sides) {}
+	Pattern::Pattern(std::vector<Wall>& walls, const int sides) : _walls(std::move(walls)), _sides(sides) {
+		// Only walls next to each other are checked, PatternFactory::instantiate puts them in order
+		for(size_t i = 0; i < _walls.size(); i++) {
+			if(!_runs.empty()) {
+				auto& run = _runs.back();
+				const auto& last = _walls[i - 1];
+				const auto& wall = _walls[i];
+				if(run.count < MAX_RUN && wall.getSide() == last.getSide() + 1 && wall.getDistance() == last.getDistance() && wall.getHeight() == last.getHeight()) {
+					run.count++;
+					continue;
+				}
+			}
+
+			_runs.push_back({i, 1});
+		}
+	}
 
 	double Pattern::getFurthestWallDistance() const {
 		const auto furthest = std::max_element(_walls.begin(), _walls.end(), [](const auto& a, const auto& b) {
@@ -35,7 +53,7 @@ namespace SuperHaxagon {
 		_name = readString(file, platform, "pattern name");
 
 		if (!readCompare(file, PATTERN_HEADER)) {
-			platform.message(Dbg::WARN, "pattern", _name + " pattern header invalid!");
+			LOG_MESSAGEF(platform, Dbg::WARN, "pattern", "%s pattern header invalid!", _name.c_str());
 			return;
 		}
 
@@ -46,8 +64,16 @@ namespace SuperHaxagon {
 		const int numWalls = read32(file, 1, 1000, platform, _name + " pattern walls");
 		for (auto i = 0; i < numWalls; i++) _walls.emplace_back(file, _sides);
 
+		// Group the walls into bands, the same wall twice would only get drawn twice
+		const auto key = [](const WallFactory& wall) {
+			return std::make_tuple(wall.getDistance(), wall.getHeight(), wall.getSide());
+		};
+
+		std::sort(_walls.begin(), _walls.end(), [&key](const auto& a, const auto& b) {return key(a) < key(b);});
+		_walls.erase(std::unique(_walls.begin(), _walls.end(), [&key](const auto& a, const auto& b) {return key(a) == key(b);}), _walls.end());
+
 		if (!readCompare(file, PATTERN_FOOTER)) {
-			platform.message(Dbg::WARN, "pattern", _name + " pattern footer invalid!");
+			LOG_MESSAGEF(platform, Dbg::WARN, "pattern", "%s pattern footer invalid!", _name.c_str());
 			return;
 		}
 
@@ -59,8 +85,22 @@ namespace SuperHaxagon {
 	Pattern PatternFactory::instantiate(Twist& rng, const double distance) const {
 		const auto offset = rng.rand(_sides - 1);
 		std::vector<Wall> active;
-		for(const auto& wall : _walls) {
-			active.emplace_back(wall.instantiate(distance, offset, _sides));
+		active.reserve(_walls.size());
+
+		// Within a band, the walls that wrap past the last side are now the lowest,
+		// so move them to the front to keep every band going up by side.
+		size_t band = 0;
+		size_t wrap = 0;
+		for(size_t i = 0; i <= _walls.size(); i++) {
+			if(i > 0 && (i == _walls.size() || _walls[i].getDistance() != _walls[band].getDistance() || _walls[i].getHeight() != _walls[band].getHeight())) {
+				std::rotate(active.begin() + band, active.begin() + wrap, active.end());
+				band = i;
+				wrap = i;
+			}
+
+			if(i == _walls.size()) break;
+			if(_walls[i].getSide() + offset < _sides) wrap = i + 1;
+			active.emplace_back(_walls[i].instantiate(distance, offset, _sides));
 		}
 
 		return {active, _sides};
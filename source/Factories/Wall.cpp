@@ -74,6 +74,27 @@ namespace SuperHaxagon {
 		return quad;
 	}
 
+	std::vector<Point> Wall::calcStrip(const Point& focus, const double rotation, const double sides, const double offset, const double scale, const int count) const {
+		auto tHeight = _height;
+		auto tDistance = _distance + offset;
+		if(tDistance < SCALE_HEX_LENGTH) {
+			tHeight -= SCALE_HEX_LENGTH - tDistance;
+			tDistance = SCALE_HEX_LENGTH;
+		}
+
+		tDistance *= scale;
+		tHeight *= scale;
+		std::vector<Point> strip;
+		strip.reserve((count + 1) * 2);
+		for(auto i = 0; i <= count; i++) {
+			const auto overflow = i == 0 ? -WALL_OVERFLOW : i == count ? WALL_OVERFLOW : 0.0;
+			strip.emplace_back(calcPoint(focus, rotation, overflow, tDistance, sides, _side + i));
+			strip.emplace_back(calcPoint(focus, rotation, overflow, tDistance + tHeight, sides, _side + i));
+		}
+
+		return strip;
+	}
+
 	Point Wall::calcPoint(const Point& focus, const double rotation, const double overflow, const double distance, const double sides, const int side) {
 		Point point = {0,0};
 		auto width = side * TAU/sides + overflow;
@@ -1,6 +1,7 @@
 #include "../../include/States/Load.hpp"
 
 #include "../../include/Core/Game.hpp"
+#include "../../include/Core/Trace.hpp"
 #include "../../include/Driver/Platform.hpp"
 #include "../../include/Factories/Level.hpp"
 #include "../../include/Factories/Pattern.hpp"
@@ -22,13 +23,14 @@ namespace SuperHaxagon {
 	Load::~Load() = default;
 
 	bool Load::loadFile(std::ifstream& file, LocLevel location) const {
+		TRACE_ZONE("Load::loadFile");
 		std::vector<std::shared_ptr<PatternFactory>> patterns;
 
 		// Used to make sure that external levels link correctly.
 		const auto levelIndexOffset = _game.getLevels().size();
 
 		if(!readCompare(file, PROJECT_HEADER)) {
-			_platform.message(Dbg::WARN, "file", "file header invalid!");
+			LOG_MESSAGE(_platform, Dbg::WARN, "file", "file header invalid!");
 			return false;
 		}
 
@@ -37,7 +39,7 @@ namespace SuperHaxagon {
 		for (auto i = 0; i < numPatterns; i++) {
 			auto pattern = std::make_shared<PatternFactory>(file, _platform);
 			if (!pattern->isLoaded()) {
-				_platform.message(Dbg::WARN, "file", "a pattern failed to load");
+				LOG_MESSAGE(_platform, Dbg::WARN, "file", "a pattern failed to load");
 				return false;
 			}
 
@@ -45,7 +47,7 @@ namespace SuperHaxagon {
 		}
 
 		if (patterns.empty()) {
-			_platform.message(Dbg::WARN, "file", "no patterns loaded");
+			LOG_MESSAGE(_platform, Dbg::WARN, "file", "no patterns loaded");
 			return false;
 		}
 
@@ -53,7 +55,7 @@ namespace SuperHaxagon {
 		for (auto i = 0; i < numLevels; i++) {
 			auto level = std::make_unique<LevelFactory>(file, patterns, location, _platform, levelIndexOffset);
 			if (!level->isLoaded()) {
-				_platform.message(Dbg::WARN, "file", "a level failed to load");
+				LOG_MESSAGE(_platform, Dbg::WARN, "file", "a level failed to load");
 				return false;
 			}
 
@@ -109,7 +111,7 @@ namespace SuperHaxagon {
 		auto files = std::filesystem::directory_iterator(tempuwu);
 		for (const auto& file : files) {
 			if (file.path().extension() != ".haxagon") continue;
-			_platform.message(Dbg::INFO, "load", "found " + file.path().string());
+			LOG_MESSAGE(_platform, Dbg::INFO, "load", "found " + file.path().string());
 			locations.emplace_back(std::pair<LocLevel, std::string>(LocLevel::EXTERNAL, file.path().string()));
 		}
 
@@ -133,6 +135,7 @@ namespace SuperHaxagon {
 	}
 
 	std::unique_ptr<State> Load::update(double) {
+		TRACE_ZONE("Load::update");
 		if (_loaded) return std::make_unique<Menu>(_game, *_game.getLevels()[0]);
 		return std::make_unique<Quit>(_game);
 	}
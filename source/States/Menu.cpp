@@ -2,6 +2,7 @@
 
 #include "../../include/Core/Game.hpp"
 #include "../../include/Core/Metadata.hpp"
+#include "../../include/Core/Trace.hpp"
 #include "../../include/Driver/Font.hpp"
 #include "../../include/Driver/Platform.hpp"
 #include "../../include/Factories/Level.hpp"
@@ -33,11 +34,12 @@ namespace SuperHaxagon {
 		_game.setSkew(0.0);
 		_game.setShadowAuto(false);
 		_game.setBGMAudio(_platform.loadAudio(_platform.getPathRom("/bgm/werq"), SuperHaxagon::Stream::INDIRECT));
-		_platform.playSFX(_game.getSFXHexagon());
+		_platform.playSFX(SoundId::HEXAGON);
 		_platform.playBGM(*_game.getBGMAudio());
 	}
 
 	std::unique_ptr<State> Menu::update(const double dilation) {
+		TRACE_ZONE("Menu::update");
 		const auto press = _platform.getPressed();
 
 		if (press.quit) return std::make_unique<Quit>(_game);
@@ -60,7 +62,7 @@ namespace SuperHaxagon {
 			}
 
 			if (_transitionDirection) {
-				_platform.playSFX(_game.getSFXSelect());
+				_platform.playSFX(SoundId::SELECT);
 				for (auto i = COLOR_LOCATION_FIRST; i != COLOR_LOCATION_LAST; i++) {
 					const auto location = static_cast<LocColor>(i);
 
@@ -108,6 +110,17 @@ namespace SuperHaxagon {
 		return nullptr;
 	}
 
+	Redraw Menu::getRedraw() const {
+		if (_transitionDirection) return Redraw::FULL;
+
+		// Levels with one color per location have nothing to fade between
+		for (const auto& colors : (*_selected)->getColors()) {
+			if (colors.second.size() > 1) return Redraw::LOW;
+		}
+
+		return Redraw::STATIC;
+	}
+
 	void Menu::drawTop(double scale) {
 		auto percentRotated = _frameRotation / FRAMES_PER_TRANSITION;
 		auto rotation = percentRotated * TAU/6.0;
@@ -138,7 +151,6 @@ namespace SuperHaxagon {
 		auto shadow = _game.getShadowOffset();
 
 		Point focus = {screen.x/2, screen.y/6 * 5};
-		Point offsetFocus = {focus.x + shadow.x, focus.y + shadow.y};
 
 		// Home screen always has 6 sides.
 		// Use a multiplier of 2 because the view is shifted down
@@ -146,8 +158,10 @@ namespace SuperHaxagon {
 		_game.drawBackground(bg1, bg2, focus, 2, rotation, 6.0);
 
 		// Shadows
-		_game.drawRegular(COLOR_SHADOW, offsetFocus, SCALE_HEX_LENGTH * SCALE_MENU * scale, rotation, 6.0);
-		_game.drawCursor(COLOR_SHADOW, offsetFocus, TAU / 4.0, 0, SCALE_HEX_LENGTH + SCALE_HUMAN_PADDING + 4, scale * SCALE_MENU * 0.75);
+		_platform.pushTransform(translate(shadow));
+		_game.drawRegular(COLOR_SHADOW, focus, SCALE_HEX_LENGTH * SCALE_MENU * scale, rotation, 6.0);
+		_game.drawCursor(COLOR_SHADOW, focus, TAU / 4.0, 0, SCALE_HEX_LENGTH + SCALE_HUMAN_PADDING + 4, scale * SCALE_MENU * 0.75);
+		_platform.popTransform();
 
 		// Geometry
 		_game.drawRegular(fg, focus,SCALE_HEX_LENGTH * SCALE_MENU * scale, rotation, 6.0);
@@ -162,10 +176,15 @@ namespace SuperHaxagon {
 
 		// Actual text
 		auto& level = **_selected;
-		auto scoreTime = "BEST: " + getTime(level.getHighScore());
-		auto diff = "DIFF: " + level.getDifficulty();
-		auto mode = "MODE: " + level.getMode();
-		auto auth = "AUTH: " + level.getCreator();
+		if (_hudLevel != &level) {
+			_hudLevel = &level;
+			_textName.set(level.getName());
+			_textDiff.set("DIFF: " + level.getDifficulty());
+			_textMode.set("MODE: " + level.getMode());
+			_textAuth.set("AUTH: " + level.getCreator());
+			_textBest.setTime("BEST: ", level.getHighScore());
+		}
+
 		auto renderCreator = level.getCreator() != "REDHAT";
 		large.setScale(scale);
 		small.setScale(scale);
@@ -179,41 +198,25 @@ namespace SuperHaxagon {
 
 		// Text background for information at top left of screen
 		Point infoSize = {std::max({
-			large.getWidth(level.getName()),
-			small.getWidth(diff),
-			small.getWidth(mode),
-			small.getWidth(auth),
+			_textName.getWidth(large, scale),
+			_textDiff.getWidth(small, scale),
+			_textMode.getWidth(small, scale),
+			_textAuth.getWidth(small, scale),
 		}) + pad * 2, posCreator.y + pad + small.getHeight()};
 
-		// Clockwise, from Top Left
-		std::vector<Point> info{
-			{0, 0},
-			{infoSize.x + infoSize.y / 2, 0},
-			{infoSize.x, infoSize.y},
-			{0, infoSize.y}
-		};
-
-		_platform.drawPoly(COLOR_TRANSPARENT, info);
+		_panelInfo.update(infoSize, screen);
+		_panelInfo.draw(_platform, COLOR_TRANSPARENT);
 
 		// Score block with triangle
-		Point timeSize = {small.getWidth(scoreTime) + pad * 2, small.getHeight() + pad * 2};
-
-		// Clockwise, from Top Left
-		const auto screenHeight = _platform.getScreenDim().y;
-		std::vector<Point> time = {
-			{0, screenHeight - timeSize.y},
-			{timeSize.x,  screenHeight - timeSize.y},
-			{timeSize.x + timeSize.y / 2, screenHeight},
-			{0,  screenHeight},
-		};
-
-		_platform.drawPoly(COLOR_TRANSPARENT, time);
-
-		large.draw(COLOR_WHITE, posTitle, Alignment::LEFT, level.getName());
-		small.draw(COLOR_GREY, posDifficulty, Alignment::LEFT, diff);
-		small.draw(COLOR_GREY, posMode, Alignment::LEFT, mode);
-		if (renderCreator) small.draw(COLOR_GREY, posCreator, Alignment::LEFT, auth);
-		small.draw(COLOR_WHITE, posTime, Alignment::LEFT, scoreTime);
+		Point timeSize = {_textBest.getWidth(small, scale) + pad * 2, small.getHeight() + pad * 2};
+		_panelTime.update(timeSize, screen);
+		_panelTime.draw(_platform, COLOR_TRANSPARENT);
+
+		_textName.draw(large, COLOR_WHITE, posTitle, Alignment::LEFT);
+		_textDiff.draw(small, COLOR_GREY, posDifficulty, Alignment::LEFT);
+		_textMode.draw(small, COLOR_GREY, posMode, Alignment::LEFT);
+		if (renderCreator) _textAuth.draw(small, COLOR_GREY, posCreator, Alignment::LEFT);
+		_textBest.draw(small, COLOR_WHITE, posTime, Alignment::LEFT);
 	}
 
 	void Menu::drawBot(double) {}
@@ -1,6 +1,7 @@
 #include "../../include/States/Over.hpp"
 
 #include "../../include/Core/Game.hpp"
+#include "../../include/Core/Trace.hpp"
 #include "../../include/Driver/Platform.hpp"
 #include "../../include/Driver/Font.hpp"
 #include "../../include/Factories/Level.hpp"
@@ -23,12 +24,22 @@ namespace SuperHaxagon {
 		_text(std::move(text)),
 		_score(score) {
 		_high = _selected.setHighScore(static_cast<int>(score));
+
+		// None of these change while the game over screen is up
+		Buttons a{};
+		a.select = true;
+		Buttons b{};
+		b.back = true;
+		_textScore.setTime("TIME: ", _score);
+		_textBest.setTime("BEST: ", _selected.getHighScore());
+		_textPlay.set("PRESS (" + _platform.getButtonName(a) + ") TO PLAY");
+		_textQuit.set("PRESS (" + _platform.getButtonName(b) + ") TO QUIT");
 	}
 
 	Over::~Over() = default;
 
 	void Over::enter() {
-		_platform.playSFX(_game.getSFXOver());
+		_platform.playSFX(SoundId::OVER);
 
 		std::ofstream scores(_platform.getPath("/scores.db"), std::ios::out | std::ios::binary);
 
@@ -51,6 +62,7 @@ namespace SuperHaxagon {
 	}
 
 	std::unique_ptr<State> Over::update(const double dilation) {
+		TRACE_ZONE("Over::update");
 		_frames += dilation;
 		_level->rotate(GAME_OVER_ROT_SPEED, dilation);
 		_level->clamp();
@@ -83,6 +95,11 @@ namespace SuperHaxagon {
 		return nullptr;
 	}
 
+	Redraw Over::getRedraw() const {
+		// Once the walls are gone only the slow spin and the pulse are left
+		return _frames >= FRAMES_PER_GAME_OVER ? Redraw::LOW : Redraw::FULL;
+	}
+
 	void Over::drawTop(const double scale) {
 		_level->draw(_game, scale, _offset);
 	}
@@ -106,28 +123,20 @@ namespace SuperHaxagon {
 		const Point posB = {width / 2, height - margin - heightSmall};
 		const Point posA = {width / 2, posB.y - heightSmall - padText};
 
-		const auto textScore = std::string("TIME: ") + getTime(_score);
 		large.draw(COLOR_WHITE, posGameOver, Alignment::CENTER,  _text);
-		small.draw(COLOR_WHITE, posTime, Alignment::CENTER, textScore);
+		_textScore.draw(small, COLOR_WHITE, posTime, Alignment::CENTER);
 
 		if(_high) {
 			const auto percent = getPulse(_frames, PULSE_TIME, 0);
 			const auto pulse = interpolateColor(PULSE_LOW, PULSE_HIGH, percent);
 			small.draw(pulse, posBest, Alignment::CENTER, "NEW RECORD!");
 		} else {
-			const auto score = _selected.getHighScore();
-			const auto textBest = std::string("BEST: ") + getTime(score);
-			small.draw(COLOR_WHITE, posBest, Alignment::CENTER, textBest);
+			_textBest.draw(small, COLOR_WHITE, posBest, Alignment::CENTER);
 		}
 
 		if(_frames >= FRAMES_PER_GAME_OVER) {
-			Buttons a{};
-			a.select = true;
-			small.draw(COLOR_WHITE, posA, Alignment::CENTER, "PRESS (" + _platform.getButtonName(a) + ") TO PLAY");
-
-			Buttons b{};
-			b.back = true;
-			small.draw(COLOR_WHITE, posB, Alignment::CENTER, "PRESS (" + _platform.getButtonName(b) + ") TO QUIT");
+			_textPlay.draw(small, COLOR_WHITE, posA, Alignment::CENTER);
+			_textQuit.draw(small, COLOR_WHITE, posB, Alignment::CENTER);
 		}
 	}
 }
@@ -2,6 +2,7 @@
 
 #include "../../include/Core/Game.hpp"
 #include "../../include/Core/Metadata.hpp"
+#include "../../include/Core/Trace.hpp"
 #include "../../include/Driver/Font.hpp"
 #include "../../include/Driver/Platform.hpp"
 #include "../../include/Driver/Player.hpp"
@@ -11,6 +12,7 @@
 #include "../../include/States/Transition.hpp"
 #include "../../include/States/Win.hpp"
 
+#include <algorithm>
 #include <cmath>
 
 namespace SuperHaxagon {
@@ -29,8 +31,13 @@ namespace SuperHaxagon {
 	void Play::enter() {
 		auto* bgm = _platform.getBGM();
 		if (bgm) bgm->play();
-		_platform.playSFX(_game.getSFXBegin());
+		_platform.playSFX(SoundId::BEGIN);
 		_game.setShadowAuto(true);
+
+		// Anything pressed before now was for the state before this one
+		_platform.pollInput(_events);
+		_buttons = _platform.getPressed();
+		_inputTime = _platform.getInputTime();
 	}
 
 	void Play::exit() {
@@ -39,6 +46,7 @@ namespace SuperHaxagon {
 	}
 
 	std::unique_ptr<State> Play::update(const double dilation) {
+		TRACE_ZONE("Play::update");
 		const auto maxRenderDistance = SCALE_BASE_DISTANCE * (_game.getScreenDimMax() / 400);
 
 		// Render the level with a skewed 3D look
@@ -56,25 +64,27 @@ namespace SuperHaxagon {
 			const auto time = bgm ? bgm->getTime() : 0.0;
 
 			// Apply effects. More can be added here if needed.
-			if (metadata.getMetadata(time, "S")) _level->spin();
-			if (metadata.getMetadata(time, "I")) _level->invertBG();
-			if (metadata.getMetadata(time, "BL")) _level->pulse(1.0);
-			if (metadata.getMetadata(time, "BS")) _level->pulse(0.5);
+			const auto events = metadata.advance(time);
+			if (events & Metadata::mask(Label::SPIN)) _level->spin();
+			if (events & Metadata::mask(Label::INVERT)) _level->invertBG();
+			if (events & Metadata::mask(Label::PULSE_LARGE)) _level->pulse(1.0);
+			if (events & Metadata::mask(Label::PULSE_SMALL)) _level->pulse(0.5);
 		}
 
 		// Update level
 		const auto previousFrame = _level->getFrame();
-		_level->update(_game.getTwister(), SCALE_HEX_LENGTH, maxRenderDistance, dilation);
+		_level->update(_game.getTwister(), _platform.getStats(), SCALE_HEX_LENGTH, maxRenderDistance, dilation);
 
 		// Button presses
-		const auto pressed = _platform.getPressed();
+		const auto held = readInput();
+		const auto& pressed = held.pressed;
 
 		// Check collision
 		const auto cursorDistance = SCALE_HEX_LENGTH + SCALE_HUMAN_PADDING + SCALE_HUMAN_HEIGHT;
 		const auto hit = _level->collision(cursorDistance, dilation);
 
 		// Keys
-		if(pressed.back || hit == Movement::DEAD) {
+		if(pressed.back || (hit == Movement::DEAD && !_platform.isImmortal())) {
 			if (&_factory != &_selected &&
 			    _factory.getCreator() == "REDHAT" && 
 			    _factory.getName() == "VOID" &&
@@ -108,12 +118,9 @@ namespace SuperHaxagon {
 			return std::make_unique<Transition>(_game, std::move(_level), _selected, _score);
 		}
 
-		// Process movement
-		if (pressed.left && hit != Movement::CANNOT_MOVE_LEFT) {
-			_level->left(dilation);
-		} else if (pressed.right && hit != Movement::CANNOT_MOVE_RIGHT) {
-			_level->right(dilation);
-		}
+		// Process movement, for as long as each way was held
+		if (held.left > 0 && hit != Movement::CANNOT_MOVE_LEFT) _level->left(dilation * held.left);
+		if (held.right > 0 && hit != Movement::CANNOT_MOVE_RIGHT) _level->right(dilation * held.right);
 
 		// Make sure the cursor doesn't extend too far
 		_level->clamp();
@@ -124,12 +131,57 @@ namespace SuperHaxagon {
 		const auto* lastScoreText = getScoreText(static_cast<int>(previousFrame), false);
 		if (lastScoreText != getScoreText(static_cast<int>(_level->getFrame()), false)) {
 			_level->increaseMultiplier();
-			_platform.playSFX(_game.getSFXLevelUp());
+			_platform.playSFX(SoundId::LEVEL_UP);
 		}
 
 		return nullptr;
 	}
 
+	Play::Held Play::readInput() {
+		if (!_platform.pollInput(_events)) {
+			// Only what is down right now, so it counts for the whole frame
+			const auto pressed = _platform.getPressed();
+			return {pressed, pressed.left ? 1.0 : 0.0, !pressed.left && pressed.right ? 1.0 : 0.0};
+		}
+
+		auto now = _platform.getInputTime();
+		if (!_events.empty()) now = std::max(now, _events.back().time);
+
+		Held held{_buttons, 0, 0};
+		auto from = _inputTime;
+		const auto hold = [&](const double until) {
+			// Left wins when both are down, same as it always has
+			const auto time = std::max(until - from, 0.0);
+			if (_buttons.left) held.left += time;
+			else if (_buttons.right) held.right += time;
+			from = std::max(from, until);
+		};
+
+		for (const auto& event : _events) {
+			hold(event.time);
+			_buttons = event.buttons;
+			held.pressed.select |= _buttons.select;
+			held.pressed.back |= _buttons.back;
+			held.pressed.quit |= _buttons.quit;
+			held.pressed.left |= _buttons.left;
+			held.pressed.right |= _buttons.right;
+		}
+
+		hold(now);
+
+		const auto span = now - _inputTime;
+		_inputTime = now;
+		if (span <= 0) {
+			held.left = _buttons.left ? 1.0 : 0.0;
+			held.right = !_buttons.left && _buttons.right ? 1.0 : 0.0;
+			return held;
+		}
+
+		held.left /= span;
+		held.right /= span;
+		return held;
+	}
+
 	void Play::drawTop(const double scale) {
 		_level->draw(_game, scale, 0);
 	}
@@ -152,27 +204,21 @@ namespace SuperHaxagon {
 
 		// Draw the top left POINT/LINE thing
 		// Note, 400 is kind of arbitrary. Perhaps it's needed to update this later.
-		const auto* levelUp = getScoreText(static_cast<int>(_level->getFrame()), _platform.getScreenDim().x <= 400);
+		const auto screen = _platform.getScreenDim();
+		_levelUpText.set(getScoreText(static_cast<int>(_level->getFrame()), screen.x <= 400));
 		const Point levelUpPosText = {pad, pad};
 		const Point levelUpBkgSize = {
-			small.getWidth(levelUp) + pad * 2,
+			_levelUpText.getWidth(small, scale) + pad * 2,
 			small.getHeight() + pad * 2
 		};
 
-		// Clockwise, from top left
-		const std::vector<Point> levelUpBkg = {
-			{0, 0},
-			{levelUpBkgSize.x + levelUpBkgSize.y / 2, 0},
-			{levelUpBkgSize.x, levelUpBkgSize.y},
-			{0, levelUpBkgSize.y},
-		};
-
-		_platform.drawPoly(COLOR_TRANSPARENT, levelUpBkg);
-		small.draw(COLOR_WHITE, levelUpPosText, Alignment::LEFT, levelUp);
+		_levelUpPanel.update(levelUpBkgSize, screen);
+		_levelUpPanel.draw(_platform, COLOR_TRANSPARENT);
+		_levelUpText.draw(small, COLOR_WHITE, levelUpPosText, Alignment::LEFT);
 
 		// Draw the current score
-		const auto screenWidth = _platform.getScreenDim().x;
-		const auto textScore = "TIME: " + getTime(_score);
+		const auto screenWidth = screen.x;
+		_scoreText.setTime("TIME: ", _score);
 		const Point scorePosText = {screenWidth - pad - _scoreWidth, pad};
 		Point scoreBkgSize = {_scoreWidth + pad * 2, small.getHeight() + pad * 2};
 
@@ -194,16 +240,9 @@ namespace SuperHaxagon {
 			}
 		}
 
-		// Clockwise, from top left
-		const std::vector<Point> scoreBkg = {
-			{screenWidth - scoreBkgSize.x - scoreBkgSize.y / 2, 0},
-			{screenWidth, 0},
-			{screenWidth, scoreBkgSize.y},
-			{screenWidth - scoreBkgSize.x, scoreBkgSize.y}
-		};
-
-		_platform.drawPoly(COLOR_TRANSPARENT, scoreBkg);
-		small.draw(COLOR_WHITE, scorePosText, Alignment::LEFT, textScore);
+		_scorePanel.update(scoreBkgSize, screen);
+		_scorePanel.draw(_platform, COLOR_TRANSPARENT);
+		_scoreText.draw(small, COLOR_WHITE, scorePosText, Alignment::LEFT);
 
 		if (drawBar) {
 			const Point barPos = {scorePosText.x, originalY};
@@ -1,11 +1,13 @@
 #include "../../include/States/Quit.hpp"
 
 #include "../../include/Core/Game.hpp"
+#include "../../include/Core/Trace.hpp"
 
 namespace SuperHaxagon {
 	Quit::Quit(Game& game) : _game(game) {}
 
 	std::unique_ptr<State> Quit::update(double) {
+		TRACE_ZONE("Quit::update");
 		_game.setRunning(false);
 		return nullptr;
 	}
@@ -1,6 +1,7 @@
 #include "../../include/States/Transition.hpp"
 
 #include "../../include/Core/Game.hpp"
+#include "../../include/Core/Trace.hpp"
 #include "../../include/Driver/Platform.hpp"
 #include "../../include/Driver/Font.hpp"
 #include "../../include/Factories/Level.hpp"
@@ -20,10 +21,11 @@ namespace SuperHaxagon {
 	Transition::~Transition() = default;
 
 	void Transition::enter() {
-		_platform.playSFX(_game.getSFXWonderful());
+		_platform.playSFX(SoundId::WONDERFUL);
 	}
 
 	std::unique_ptr<State> Transition::update(const double dilation) {
+		TRACE_ZONE("Transition::update");
 		_frames += dilation;
 		_level->rotate(_level->getLevelFactory().getSpeedRotation(), dilation);
 		_level->clamp();
@@ -56,23 +58,18 @@ namespace SuperHaxagon {
 		auto& large = _game.getFontLarge();
 		large.setScale(scale);
 
-		const auto* const text = "WONDERFUL";
+		_text.set("WONDERFUL");
 		const auto pad = 6 * scale;
-		const auto width = large.getWidth(text);
-		const auto center = _platform.getScreenDim().x / 2;
+		const auto width = _text.getWidth(large, scale);
+		const auto screen = _platform.getScreenDim();
 
-		const Point posText = {center, pad};
+		const Point posText = {screen.x / 2, pad};
 		const Point bkgSize = {width + pad * 2, large.getHeight() + pad * 2};
-		const std::vector<Point> trap = {
-			{center - bkgSize.x/2 - bkgSize.y/2, 0},
-			{center + bkgSize.x/2 + bkgSize.y/2, 0},
-			{center + bkgSize.x/2, bkgSize.y},
-			{center - bkgSize.x/2, bkgSize.y},
-		};
+		_panel.update(bkgSize, screen);
 
 		const auto percent = getPulse(_frames, Play::PULSE_TIME, 0);
 		const auto pulse = interpolateColor(PULSE_LOW, PULSE_HIGH, percent);
-		_platform.drawPoly(COLOR_TRANSPARENT, trap);
-		large.draw(pulse, posText, Alignment::CENTER, text);
+		_panel.draw(_platform, COLOR_TRANSPARENT);
+		_text.draw(large, pulse, posText, Alignment::CENTER);
 	}
 }
@@ -2,6 +2,7 @@
 
 #include "../../include/Core/Game.hpp"
 #include "../../include/Core/Metadata.hpp"
+#include "../../include/Core/Trace.hpp"
 #include "../../include/Driver/Font.hpp"
 #include "../../include/Driver/Platform.hpp"
 #include "../../include/Factories/Level.hpp"
@@ -78,6 +79,7 @@ namespace SuperHaxagon {
 	}
 	
 	std::unique_ptr<State> Win::update(const double dilation) {
+		TRACE_ZONE("Win::update");
 		if (!_level) {
 			_platform.message(Dbg::FATAL, "win", "not all levels exist");
 			return std::make_unique<Quit>(_game);
@@ -103,10 +105,12 @@ namespace SuperHaxagon {
 
 		// Keep track of time so we know when the song loops
 		_lastTime = time;
+		const auto events = metadata.advance(time);
 
 		// Check for level transition labels
 		for (auto i = LEVEL_HARD; i <= LEVEL_VOID; i++) {
-			if (!metadata.getMetadata(time, "L" + std::to_string(i))) continue;
+			const auto label = static_cast<Label>(static_cast<int>(Label::LEVEL_0) + i);
+			if (!(events & Metadata::mask(label))) continue;
 
 			const auto& factory = _game.getLevels()[i].get();
 			_level->setWinFactory(factory);
@@ -125,16 +129,16 @@ namespace SuperHaxagon {
 		}
 
 		// Apply effects. More can be added here if needed.
-		if (metadata.getMetadata(time, "HYPER")) {
+		if (events & Metadata::mask(Label::HYPER)) {
 			_level->setWinFrame(60.0 * 60.0);
 			_level->spin();
 		}
 
-		if (metadata.getMetadata(time, "PSURROUND")) _level->getPatterns().emplace_front(*_surround);
-		if (metadata.getMetadata(time, "BL")) _level->pulse(1.0);
-		if (metadata.getMetadata(time, "BS")) _level->pulse(0.5);
-		if (metadata.getMetadata(time, "I")) _level->invertBG();
-		if (metadata.getMetadata(time, "C")) {
+		if (events & Metadata::mask(Label::SURROUND)) _level->getPatterns().emplace_front(*_surround);
+		if (events & Metadata::mask(Label::PULSE_LARGE)) _level->pulse(1.0);
+		if (events & Metadata::mask(Label::PULSE_SMALL)) _level->pulse(0.5);
+		if (events & Metadata::mask(Label::INVERT)) _level->invertBG();
+		if (events & Metadata::mask(Label::CREDITS)) {
 			_index++;
 			_timer = CREDITS_TIMER;
 			if (_index >= _credits.size()) _index = _credits.size() - 1;
@@ -144,7 +148,7 @@ namespace SuperHaxagon {
 
 		const auto maxRenderDistance = SCALE_BASE_DISTANCE * (_game.getScreenDimMax() / 400);
 		auto& level = *_level;
-		level.update(_game.getTwister(), maxRenderDistance, 0, dilation);
+		level.update(_game.getTwister(), _platform.getStats(), maxRenderDistance, 0, dilation);
 		
 		return nullptr;
 	}
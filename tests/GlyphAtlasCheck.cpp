@@ -0,0 +1,113 @@
+#include "../include/Core/GlyphAtlas.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace SuperHaxagon;
+
+// Every string the game draws is made of these
+static const std::vector<std::string> SAMPLES = {
+	"SUPER HAXAGON",
+	"PRESS A TO PLAY",
+	"TIME: 123:45",
+	"hexagon! {rank} [#1] 0.5% ~_~",
+	"",
+	" ",
+};
+
+static int failures = 0;
+
+static void fail(const std::string& atlas, const std::string& why) {
+	std::cout << atlas << ": " << why << std::endl;
+	failures++;
+}
+
+struct Rect {
+	char c;
+	int x0, y0, x1, y1;
+};
+
+/**
+ * Glyphs have to land on whole texels inside the texture without touching
+ * each other, and layout has to move the pen by exactly getWidth.
+ */
+static void check(const std::string& name, const GlyphAtlas& atlas) {
+	if (!atlas.isLoaded()) {
+		fail(name, "did not load");
+		return;
+	}
+
+	const auto width = atlas.getTextureWidth();
+	const auto height = atlas.getTextureHeight();
+	if (atlas.getPixels().size() != static_cast<size_t>(width) * height) fail(name, "pixels don't match the texture size");
+
+	std::vector<Rect> rects;
+	for (auto c = GlyphAtlas::GLYPH_START; c < GlyphAtlas::GLYPH_END; c++) {
+		const auto& glyph = atlas.getGlyph(static_cast<char>(c));
+		const auto label = name + " '" + static_cast<char>(c) + "'";
+		if (glyph.size.x <= 0 || glyph.size.y <= 0) continue;
+
+		const auto u0 = glyph.uv0.x * width;
+		const auto v0 = glyph.uv0.y * height;
+		const auto u1 = glyph.uv1.x * width;
+		const auto v1 = glyph.uv1.y * height;
+		if (glyph.uv0.x < 0 || glyph.uv0.y < 0 || glyph.uv1.x > 1 || glyph.uv1.y > 1) fail(label, "uvs are outside of the texture");
+		if (std::abs(u1 - u0 - glyph.size.x) > 1e-6 || std::abs(v1 - v0 - glyph.size.y) > 1e-6) fail(label, "uvs don't span the glyph size");
+		if (std::abs(u0 - std::round(u0)) > 1e-6 || std::abs(v0 - std::round(v0)) > 1e-6) fail(label, "uvs are between texels");
+		if (-glyph.offset.y > atlas.getAscent()) fail(label, "rises above the ascent");
+
+		// Padding belongs to the glyph, so it can't overlap a neighbour either
+		rects.push_back({
+			static_cast<char>(c),
+			static_cast<int>(std::lround(u0)),
+			static_cast<int>(std::lround(v0)),
+			static_cast<int>(std::lround(u1)) + GlyphAtlas::PADDING,
+			static_cast<int>(std::lround(v1)) + GlyphAtlas::PADDING
+		});
+	}
+
+	for (size_t i = 0; i < rects.size(); i++) {
+		for (auto j = i + 1; j < rects.size(); j++) {
+			const auto& a = rects[i];
+			const auto& b = rects[j];
+			if (a.x0 < b.x1 && b.x0 < a.x1 && a.y0 < b.y1 && b.y0 < a.y1) {
+				fail(name, std::string("'") + a.c + "' overlaps '" + b.c + "'");
+			}
+		}
+	}
+
+	// A marker glyph after the text shows where layout left the pen
+	const auto& marker = atlas.getGlyph('X');
+	std::vector<GlyphAtlas::Quad> quads;
+	for (const auto& sample : SAMPLES) {
+		quads.clear();
+		atlas.layout(sample + "X", {0, 0}, quads);
+		const auto expected = std::round(atlas.getWidth(sample) + marker.offset.x);
+		if (quads.empty() || quads.back().position.x != expected) {
+			fail(name, "layout of \"" + sample + "\" doesn't advance by getWidth");
+		}
+
+		for (const auto& quad : quads) {
+			if (quad.position.y < 0) fail(name, "layout of \"" + sample + "\" draws above its top");
+		}
+	}
+}
+
+int main(const int argc, char** argv) {
+	if (argc < 2) {
+		std::cout << "usage: " << argv[0] << " FONT.ttf" << std::endl;
+		return 2;
+	}
+
+	// Sizes the drivers ask for, after their own scaling
+	for (const auto size : {16.0, 32.0, 64.0}) {
+		const auto suffix = " at " + std::to_string(static_cast<int>(size));
+		check(argv[1] + suffix, GlyphAtlas(argv[1], size));
+		check("blocks" + suffix, GlyphAtlas(size));
+	}
+
+	std::cout << (failures ? std::to_string(failures) + " failures" : "every atlas passed") << std::endl;
+	return failures ? 1 : 0;
+}